@@ -0,0 +1,41 @@
+#ifndef BATCH_SOLVER_H
+#define BATCH_SOLVER_H
+
+#include "solver.h"
+
+// Solves several puzzles at once. Candidate masks of up to 16 puzzles are
+// interleaved cell by cell, one puzzle per vector lane, and naked/hidden singles
+// plus locked candidates (pointing/claiming) run as vector ops over the whole
+// batch. Lanes that still need a guess afterwards finish on the scalar
+// backtracking engine.
+class BatchSolver {
+public:
+    enum class Kernel {
+        Auto,       // AVX2 when the CPU has it, portable otherwise
+        Portable,   // 8 lanes in generic vectors (SSE2 on x86-64, NEON on arm64)
+        Avx2        // 16 lanes in 256-bit registers
+    };
+
+    static const int MAX_LANES = 16;
+
+    explicit BatchSolver(Kernel kernel = Kernel::Auto);
+
+    int getLanes() const { return kernel == Kernel::Avx2 ? 16 : 8; }
+    const char* getKernelName() const { return kernel == Kernel::Avx2 ? "avx2" : "portable"; }
+    static bool hasAvx2();
+
+    // Solves `count` (at most getLanes()) puzzles in place. solved[i] tells
+    // whether grids[i] now holds a solution; unsolvable grids are left as they were.
+    void solve(SudokuGrid* grids, bool* solved, int count);
+
+    // Lanes finished by vector propagation alone vs. handed to the scalar engine
+    uint64_t getVectorSolved() const { return vectorSolved; }
+    uint64_t getScalarFallbacks() const { return scalarFallbacks; }
+
+private:
+    Kernel kernel;
+    uint64_t vectorSolved;
+    uint64_t scalarFallbacks;
+};
+
+#endif // BATCH_SOLVER_H
@@ -0,0 +1,39 @@
+#ifndef CANONICAL_H
+#define CANONICAL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "solver.h"
+
+// Canonical form of a 9x9 puzzle: the lexicographically smallest grid reachable by
+// the transforms that keep a puzzle valid (transposition, band and stack order,
+// row and column order within them, digit relabeling). Two puzzles are isomorphic
+// exactly when their canonical forms match. Empty cells count as 0 and digits are
+// numbered in order of first appearance, so the smallest grid is well defined.
+//
+// The search picks output rows one at a time and keeps only the partial
+// transforms that tie for the smallest prefix, so it never walks all ~3.3M of
+// them; a puzzle with few clues and many automorphisms keeps more ties alive.
+SudokuGrid canonicalForm(const SudokuGrid& puzzle);
+uint64_t canonicalHash(const SudokuGrid& puzzle);   // 64-bit hash of canonicalForm, never 0
+
+// Set of canonical hashes for rejecting isomorphic duplicates in bulk: open
+// addressing, 8 bytes per slot and at most half full, so tens of millions of
+// puzzles fit in a few hundred MB and every lookup is O(1). Not thread-safe.
+class CanonicalIndex {
+public:
+    explicit CanonicalIndex(size_t expected = 0);
+    bool insert(uint64_t hash);     // false when the hash was already there
+    bool contains(uint64_t hash) const;
+    size_t size() const { return count; }
+
+private:
+    std::vector<uint64_t> slots;    // 0 marks a free slot
+    size_t count;
+
+    size_t find(uint64_t hash) const;
+    void grow();
+};
+
+#endif // CANONICAL_H
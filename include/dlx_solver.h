@@ -0,0 +1,43 @@
+#ifndef DLX_SOLVER_H
+#define DLX_SOLVER_H
+
+#include "solver.h"
+
+// Knuth's Algorithm X on dancing links. The exact-cover matrix for an empty 9x9
+// board is built once into a fixed node arena; each solve covers the givens,
+// searches, then uncovers them again so the arena is reused as-is.
+class DlxSolver : public Solver {
+public:
+    DlxSolver();
+
+    int solve(SudokuGrid& grid, int limit = 1) override;
+
+private:
+    static const int N = SudokuTables::GRID_SIZE;
+    static const int COLUMNS = 4 * SudokuTables::CELL_COUNT;   // cell, row-digit, col-digit, box-digit
+    static const int ROWS = SudokuTables::CELL_COUNT * N;       // one row per (cell, digit)
+    static const int ROOT = 0;
+    static const int NODE_COUNT = 1 + COLUMNS + ROWS * 4;
+
+    struct Node {
+        int16_t left, right, up, down;
+        int16_t column;
+        int16_t row;
+    };
+
+    std::array<Node, NODE_COUNT> nodes;
+    std::array<int16_t, COLUMNS + 1> columnSize;
+    std::array<int16_t, SudokuTables::CELL_COUNT> chosen;  // rows picked by the search, by depth
+    int depth;
+    int solutionLimit;
+    int solutionCount;
+    SudokuGrid* firstSolution;
+
+    static int rowNode(int row) { return 1 + COLUMNS + row * 4; }
+
+    void cover(int column);
+    void uncover(int column);
+    bool search();
+};
+
+#endif // DLX_SOLVER_H
@@ -4,6 +4,13 @@
 #include <SDL2/SDL.h>
 #include "sudoku.h"
 #include "renderer.h"
+#include "puzzle_pool.h"
+#include "puzzle_db.h"
+#include "grader.h"
+#include "hint.h"
+#include "move_history.h"
+#include "latency_histogram.h"
+#include "rng.h"
 
 enum class GameState {
     MENU,
@@ -12,10 +19,15 @@ enum class GameState {
     VICTORY
 };
 
-class Game {
+// The whole game for one board size; defined for 9x9, 16x16 and 25x25 in game.cpp
+template <int Box>
+class BasicGame {
 public:
-    Game();
-    ~Game();
+    static const int GRID_SIZE = BasicSudoku<Box>::GRID_SIZE;
+    static const size_t HISTORY_MOVES = 4096;   // undo depth; older moves are dropped
+
+    BasicGame();
+    ~BasicGame();
 
     bool init();
     void run();
@@ -23,7 +35,17 @@ public:
 
 private: 
     Renderer renderer;
-    Sudoku sudoku;
+    BasicSudoku<Box> sudoku;
+    BasicPuzzlePool<Box> puzzlePool;
+    PuzzleDb puzzleBank;
+    Rng bankRng;
+    Grader grader;
+    HintEngine hints;
+    MoveHistory<HISTORY_MOVES> history;
+    BasicGrid<Box> solution;    // of the current puzzle, for finding mistakes
+    bool hasSolution;
+    bool pencilMode;            // digit keys toggle notes instead of placing
+    LatencyHistogram newPuzzleMicros[BasicPuzzlePool<Box>::LEVELS];   // per difficulty, what the player waits
     int difficulty; 
     bool running;
     GameState state;
@@ -38,8 +60,23 @@ private:
     void handleEvents();
     void handleMouseClick(int x, int y);
     void handleKeyPress(SDL_Keycode key);
+    bool enterNumber(int row, int col, int num);    // setNumber that goes into the history
+    bool enterNote(int row, int col, int num);
+    void applyMove(const Move& move, bool forward);
+    void undoMove();
+    void redoMove();
+    void rewindToFirstMistake();
     void checkWinCondition();
+    void loadNewPuzzle();
+    void reportLatency() const;
     void updateTimer();
+    static int keyDigit(SDL_Keycode key);     // board digit for a key, 0 when the key is not one
 };
 
+extern template class BasicGame<3>;
+extern template class BasicGame<4>;
+extern template class BasicGame<5>;
+
+using Game = BasicGame<3>;
+
 #endif
\ No newline at end of file
@@ -0,0 +1,98 @@
+#ifndef GRADER_H
+#define GRADER_H
+
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include "solver.h"
+
+// Human solving techniques, easiest first; the order is the difficulty ranking
+enum class Technique : uint8_t {
+    None,
+    HiddenSingle,
+    NakedSingle,
+    Pointing,           // box candidates confined to one line
+    Claiming,           // line candidates confined to one box
+    NakedPair,
+    HiddenPair,
+    NakedTriple,
+    HiddenTriple,
+    XWing,
+    XYWing,
+    Swordfish,
+    Guess               // nothing above applies; needs trial and error
+};
+
+const char* getTechniqueName(Technique technique);
+
+// One deduction: either a placement or an elimination of `removeDigits` from every `affected` cell
+struct LogicStep {
+    static const int MAX_PATTERN = 9;
+
+    Technique technique = Technique::None;
+    int cell = -1;                              // placement target, -1 for eliminations
+    int digit = 0;
+    int unit = -1;                              // unit the step was found in, when there is one
+    uint16_t removeDigits = 0;
+    std::bitset<SudokuTables::CELL_COUNT> affected;
+    uint8_t pattern[MAX_PATTERN] = {};          // cells that justify the step
+    int patternSize = 0;
+
+    bool isPlacement() const { return cell >= 0; }
+    void addPattern(int patternCell) {
+        if (patternSize < MAX_PATTERN) pattern[patternSize++] = static_cast<uint8_t>(patternCell);
+    }
+};
+
+struct Grade {
+    int score = 0;                              // weighted sum over every step taken
+    Technique hardest = Technique::None;
+    int steps = 0;
+    bool solved = false;                        // false when logic alone got stuck
+
+    int getLevel() const;                       // 1 easy, 2 medium, 3 hard
+};
+
+// Solves the way a person would: at every step it applies the easiest
+// technique that makes progress, on bitmask candidates
+class Grader {
+public:
+    Grader();
+
+    void load(const SudokuGrid& grid);
+    bool findStep(LogicStep& step) const;      // false when stuck, solved or broken
+    void apply(const LogicStep& step);
+
+    bool isSolved() const { return filled == SudokuTables::CELL_COUNT; }
+    bool isBroken() const { return broken; }    // clashing givens, or a cell or unit ran out of options
+    int getDigit(int cell) const { return grid[cell]; }
+    uint16_t getCandidates(int cell) const { return candidates[cell]; }
+
+    Grade grade(const SudokuGrid& puzzle);
+
+private:
+    SudokuGrid grid;
+    std::array<uint16_t, SudokuTables::CELL_COUNT> candidates;   // 0 for filled cells
+    // unitPlaces[unit][digit - 1]: bit i set when unit cell i may hold digit; kept in step with candidates
+    std::array<std::array<uint16_t, SudokuTables::GRID_SIZE>, SudokuTables::UNIT_COUNT> unitPlaces;
+    std::array<uint16_t, SudokuTables::UNIT_COUNT> placedDigits;
+    int filled;
+    bool broken;
+
+    bool findHiddenSingle(LogicStep& step) const;
+    bool findNakedSingle(LogicStep& step) const;
+    bool findPointing(LogicStep& step) const;
+    bool findClaiming(LogicStep& step) const;
+    bool findNakedSubset(LogicStep& step, int size) const;
+    bool findHiddenSubset(LogicStep& step, int size) const;
+    bool findFish(LogicStep& step, int size) const;
+    bool findXYWing(LogicStep& step) const;
+
+    void placeDigit(int cell, int digit);
+    void removeCandidates(int cell, uint16_t digits);
+    uint16_t unitPositions(int unit, int digit) const { return unitPlaces[unit][digit - 1]; }
+    bool collectEliminations(LogicStep& step, const uint8_t* cells, int count, uint16_t digits,
+                             const std::bitset<SudokuTables::CELL_COUNT>& exclude) const;
+};
+
+#endif // GRADER_H
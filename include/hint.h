@@ -0,0 +1,49 @@
+#ifndef HINT_H
+#define HINT_H
+
+#include <bitset>
+#include <string>
+#include "sudoku.h"
+#include "grader.h"
+
+enum class HintKind : uint8_t {
+    None,
+    Step,           // a placement or elimination; Technique::Guess when logic is stuck
+    Mistakes,       // user digits that disagree with the solution
+    Solved,
+    NoSolution      // the givens clash or do not pin down one solution
+};
+
+struct Hint {
+    HintKind kind = HintKind::None;
+    LogicStep step;
+    std::bitset<SudokuTables::CELL_COUNT> mistakes;
+
+    std::string describe() const;   // one line for the status bar, e.g. "Hidden Single: r3c6 = 5"
+};
+
+// Next deduction for the board a player is looking at. Candidates, the
+// solution and the eliminations already hinted are kept between calls and
+// only brought up to date with the cells that changed, so a hint costs a
+// single findStep. 9x9 only, like the grader it is built on.
+class HintEngine {
+public:
+    HintEngine();
+
+    void reset(const Sudoku& sudoku);       // new puzzle: solves the givens once, ahead of any hint
+    Hint nextHint(const Sudoku& sudoku);
+    bool hasUniqueSolution() const { return hasSolution; }
+    const SudokuGrid& getSolution() const { return solution; }   // of the givens passed to reset()
+
+private:
+    Grader grader;
+    SudokuGrid givens;
+    SudokuGrid solution;
+    SudokuGrid synced;          // digits the grader holds
+    bool hasSolution;
+    bool loaded;
+
+    void sync(const SudokuGrid& digits);
+};
+
+#endif // HINT_H
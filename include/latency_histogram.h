@@ -0,0 +1,60 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <algorithm>
+#include <cstdint>
+
+// HDR-style histogram: every power-of-two range of values is split into 16 equal
+// buckets, so any recorded value is known to within about 6% while the whole
+// 64-bit range fits in a fixed 4 KB. Values are in whatever unit the caller picks.
+class LatencyHistogram {
+public:
+    LatencyHistogram() : counts{}, total(0), maxValue(0) {}
+
+    void record(uint64_t value) {
+        counts[bucketOf(value)]++;
+        total++;
+        maxValue = std::max(maxValue, value);
+    }
+
+    uint64_t count() const { return total; }
+    uint64_t max() const { return maxValue; }
+
+    // Upper bound of the bucket holding the q-th quantile (0 < q <= 1), capped at the exact max
+    uint64_t percentile(double q) const {
+        if (total == 0) return 0;
+        uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(q * total + 0.999999));
+        uint64_t seen = 0;
+        for (int i = 0; i < BUCKETS; i++) {
+            seen += counts[i];
+            if (seen >= rank) return std::min(bucketTop(i), maxValue);
+        }
+        return maxValue;
+    }
+
+private:
+    static const int SUB_BITS = 4;
+    static const int SUB_BUCKETS = 1 << SUB_BITS;
+    static const int BUCKETS = 64 * SUB_BUCKETS;
+
+    uint32_t counts[BUCKETS];
+    uint64_t total;
+    uint64_t maxValue;
+
+    // Values below 2 * SUB_BUCKETS get a bucket each; above that a bucket spans 2^shift values
+    static int bucketOf(uint64_t value) {
+        if (value < SUB_BUCKETS) return static_cast<int>(value);
+        int shift = (63 - __builtin_clzll(value)) - SUB_BITS;
+        return (shift + 1) * SUB_BUCKETS + static_cast<int>((value >> shift) & (SUB_BUCKETS - 1));
+    }
+
+    static uint64_t bucketTop(int bucket) {
+        int group = bucket / SUB_BUCKETS;
+        uint64_t sub = bucket % SUB_BUCKETS;
+        if (group == 0) return sub;
+        int shift = group - 1;
+        return ((SUB_BUCKETS + sub) << shift) + ((uint64_t(1) << shift) - 1);
+    }
+};
+
+#endif // LATENCY_HISTOGRAM_H
@@ -0,0 +1,48 @@
+#ifndef MOVE_HISTORY_H
+#define MOVE_HISTORY_H
+
+#include <cstddef>
+#include <cstdint>
+
+// One edit of one cell with its pencil-mark side effects; 16 bytes, so long sessions stay cheap
+struct Move {
+    uint16_t cell;
+    uint8_t before;         // digit before the move, 0 for empty
+    uint8_t after;
+    uint32_t notesFlip;     // the cell's own notes that the move toggled
+    uint64_t peersCleared;  // peers (bit i = peers[cell][i]) whose note for `after` the move erased
+};
+
+// Undo/redo log over a fixed ring. Recording, undo and redo are O(1) and never
+// allocate; past Capacity moves the oldest ones are forgotten.
+template <size_t Capacity>
+class MoveHistory {
+public:
+    MoveHistory() : oldest(0), cursor(0), newest(0) {}
+
+    void clear() { oldest = cursor = newest = 0; }
+
+    // A new move drops whatever could have been redone
+    void record(const Move& move) {
+        moves[cursor % Capacity] = move;
+        newest = ++cursor;
+        if (newest - oldest > Capacity) oldest = newest - Capacity;
+    }
+
+    bool canUndo() const { return cursor > oldest; }
+    bool canRedo() const { return cursor < newest; }
+    const Move& undo() { return moves[--cursor % Capacity]; }     // the move to revert
+    const Move& redo() { return moves[cursor++ % Capacity]; }     // the move to apply again
+
+    // Moves that can still be undone, oldest first
+    size_t undoableCount() const { return static_cast<size_t>(cursor - oldest); }
+    const Move& undoable(size_t i) const { return moves[(oldest + i) % Capacity]; }
+
+private:
+    Move moves[Capacity];
+    uint64_t oldest;    // positions count moves ever recorded; slots are position % Capacity
+    uint64_t cursor;    // next move to redo, one past the next to undo
+    uint64_t newest;
+};
+
+#endif // MOVE_HISTORY_H
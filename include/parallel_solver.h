@@ -0,0 +1,74 @@
+#ifndef PARALLEL_SOLVER_H
+#define PARALLEL_SOLVER_H
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "solver.h"
+
+// One board, many threads: the backtracker's search tree is split into subtrees
+// that workers trade through work-stealing deques. A worker keeps exploring its
+// newest subtree and, while another worker is idle, hands over the siblings of the
+// node it is at; idle workers steal the oldest (shallowest, so biggest) subtree of
+// a busy one. Everyone stops as soon as `limit` solutions are in.
+//
+// Boards the plain backtracker finishes within SEQUENTIAL_NODES never start a
+// thread, so easy puzzles cost what they always did. When a board has several
+// solutions, which one is written back depends on timing.
+template <int Box>
+class BasicParallelSolver : public BasicSolver<Box> {
+public:
+    using Tables = BasicSudokuTables<Box>;
+    using Grid = BasicGrid<Box>;
+
+    explicit BasicParallelSolver(int threads = 0);   // 0 = all cores
+
+    int solve(Grid& grid, int limit = 1) override;
+
+    int getThreads() const { return static_cast<int>(workers.size()); }
+    uint64_t getSteals() const { return steals; }   // subtrees taken from another worker in the last solve
+
+private:
+    using Backtracker = BasicBacktrackingSolver<Box>;
+    using State = typename Backtracker::State;
+    using Choice = typename Backtracker::Choice;
+
+    // About a millisecond of plain search; nodes cost far more on big boards
+    static const uint64_t SEQUENTIAL_NODES = Box == 3 ? 2000 : (Box == 4 ? 200 : 40);
+    static const int IDLE_SPINS = 64;   // empty polls before an idle worker starts sleeping
+
+    // The owner pushes and pops at the back, thieves take from the front
+    struct Worker {
+        std::mutex mutex;
+        std::deque<State> tasks;
+    };
+
+    Backtracker sequential;
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    Grid* firstSolution;
+    int solutionLimit;
+    std::mutex solutionMutex;
+    std::atomic<int> solutionCount;
+    std::atomic<bool> stopping;
+    std::atomic<long> pending;       // subtrees queued or being searched
+    std::atomic<int> idle;           // workers that found nothing to take
+    std::atomic<uint64_t> steals;
+#ifdef SUDOKU_STATS
+    SolverStats workerStats;         // counted on the pool threads, added to the caller's by solve()
+#endif
+
+    void run(int self);
+    bool takeTask(int self, State& task);
+    void search(int self, State& state);
+};
+
+extern template class BasicParallelSolver<3>;
+extern template class BasicParallelSolver<4>;
+extern template class BasicParallelSolver<5>;
+
+using ParallelSolver = BasicParallelSolver<3>;
+
+#endif // PARALLEL_SOLVER_H
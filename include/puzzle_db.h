@@ -0,0 +1,78 @@
+#ifndef PUZZLE_DB_H
+#define PUZZLE_DB_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// On-disk puzzle bank. Layout (little-endian):
+//   PuzzleDbHeader, then PackedPuzzle records sorted by difficulty, so the
+//   header's per-level offset/count pairs double as the index.
+// Records are fixed-size and 8-byte aligned, so a mapped file is read in place.
+
+struct PackedPuzzle {
+    static const int CELL_BYTES = 41;   // 81 cells, 4 bits each, low nibble first
+
+    uint64_t seed;                      // generator seed, 0 when unknown
+    uint8_t difficulty;                 // 1..3
+    uint8_t clues;
+    uint8_t cells[CELL_BYTES];
+    uint8_t symmetry;                   // Symmetry of the clue pattern, 0 = none
+    uint8_t reserved[4];
+
+    int getCell(int cell) const { return (cells[cell / 2] >> ((cell % 2) * 4)) & 0x0F; }
+    void setCell(int cell, int num) {
+        int shift = (cell % 2) * 4;
+        cells[cell / 2] = static_cast<uint8_t>((cells[cell / 2] & ~(0x0F << shift)) | (num << shift));
+    }
+};
+
+struct PuzzleDbHeader {
+    static const int LEVELS = 3;
+
+    char magic[4];                      // "SDKB"
+    uint32_t version;
+    uint32_t recordSize;
+    uint32_t reserved;
+    uint64_t levelOffset[LEVELS];       // index of the first record of each difficulty
+    uint64_t levelCount[LEVELS];
+};
+
+static_assert(sizeof(PackedPuzzle) == 56, "PackedPuzzle layout is part of the file format");
+static_assert(sizeof(PuzzleDbHeader) == 64, "PuzzleDbHeader layout is part of the file format");
+
+// Read-only view of a bank file through mmap; lookups neither parse nor allocate
+class PuzzleDb {
+public:
+    PuzzleDb();
+    ~PuzzleDb();
+    PuzzleDb(const PuzzleDb&) = delete;
+    PuzzleDb& operator=(const PuzzleDb&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return header != nullptr; }
+
+    size_t getCount(int difficulty) const;
+    const PackedPuzzle* get(int difficulty, size_t index) const;   // nullptr when out of range
+
+private:
+    void* mapping;
+    size_t mappingSize;
+    const PuzzleDbHeader* header;
+    const PackedPuzzle* records;
+};
+
+// Collects records in memory and writes them grouped by difficulty
+class PuzzleDbWriter {
+public:
+    void add(const PackedPuzzle& puzzle);
+    bool write(const std::string& path) const;
+    size_t size() const;
+
+private:
+    std::vector<PackedPuzzle> levels[PuzzleDbHeader::LEVELS];
+};
+
+#endif // PUZZLE_DB_H
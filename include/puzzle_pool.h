@@ -0,0 +1,50 @@
+#ifndef PUZZLE_POOL_H
+#define PUZZLE_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include "sudoku.h"
+#include "spsc_ring.h"
+
+// Keeps a few ready-made puzzles per difficulty, generated on a background thread,
+// so starting a new game never waits on the generator. Defined for Box = 3, 4 and 5.
+template <int Box>
+class BasicPuzzlePool {
+public:
+    static const int LEVELS = 3;        // difficulty 1..3
+    static const int DEPTH = 4;         // ready puzzles kept per level
+
+    BasicPuzzlePool();
+    ~BasicPuzzlePool();
+
+    void start();
+    void stop();
+
+    // Pops a ready puzzle in O(1); returns false when that level's queue is empty
+    bool acquire(int difficulty, BasicSudoku<Box>& out);
+
+    uint64_t getHits() const { return hits.load(std::memory_order_relaxed); }
+    uint64_t getMisses() const { return misses.load(std::memory_order_relaxed); }
+
+private:
+    SpscRing<BasicSudoku<Box>, DEPTH> queues[LEVELS];
+    std::thread worker;
+    std::atomic<bool> running;
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    std::atomic<uint64_t> hits;
+    std::atomic<uint64_t> misses;
+
+    void workerLoop();
+};
+
+extern template class BasicPuzzlePool<3>;
+extern template class BasicPuzzlePool<4>;
+extern template class BasicPuzzlePool<5>;
+
+using PuzzlePool = BasicPuzzlePool<3>;
+
+#endif // PUZZLE_POOL_H
@@ -6,10 +6,11 @@
 #include <SDL2/SDL_image.h>
 #include <string>
 #include "sudoku.h"
+#include "hint.h"
 
 class Renderer {
 public:
-    static const int CELL_SIZE = 60;
+    static const int CELL_SIZE = 60;   // on 9x9; bigger boards share the same grid area
     static const int WINDOW_WIDTH = CELL_SIZE * Sudoku::GRID_SIZE + 100;
     static const int WINDOW_HEIGHT = CELL_SIZE * Sudoku::GRID_SIZE + 100;
 
@@ -17,7 +18,9 @@ public:
     ~Renderer();
 
     bool init();
-    void render(const Sudoku& sudoku, int selectedRow = -1, int selectedCol = -1);
+    // Board methods are defined for the 9x9, 16x16 and 25x25 boards; the layout follows the board
+    template <int Box>
+    void render(const BasicSudoku<Box>& sudoku, int selectedRow = -1, int selectedCol = -1);
     void getGridPosition(int x, int y, int& row, int& col);     // convert mouse coordinates to grid position / where mousee points to
     void close();
     void renderTimer(int elapsedSeconds);
@@ -25,23 +28,102 @@ public:
     void renderMenuScreen();
     void renderDifficultyScreen();
     int handleDifficultyClick(int x, int y);
-    void completeEffect(const Sudoku& sudoku, int originRow, int originCol, int durationMs = 1200);
+    template <int Box>
+    void completeEffect(const BasicSudoku<Box>& sudoku, int originRow, int originCol, int durationMs = 1200);
     int handleVictoryScreenClick(int x, int y);
     bool handleMenuClick(int x, int y);
+    void setRating(const std::string& label) { ratingLabel = label; }
+    void setPuzzleId(const std::string& id);
+    void setHint(const Hint& shown);    // highlighted on 9x9 boards until cleared
+    void clearHint() { hint = Hint(); }
+    void setPencilMode(bool on) { pencilMode = on; }
+#ifdef SUDOKU_STATS
+    void toggleStatsOverlay() { showStats = !showStats; }
+#endif
     
 private:
     SDL_Window* window;
     SDL_Renderer* renderer;
     TTF_Font* font;
+    TTF_Font* noteFont;         // pencil marks; falls back to `font` when missing
     SDL_Surface* icon;
+    std::string ratingLabel;    // grader's verdict on the current puzzle, drawn top-right
+    Hint hint;
+    std::string hintLabel;      // replaces the rating while a hint is shown
+    bool pencilMode;
+    SDL_Texture* labelTexture;  // whichever label is shown, rasterized again only when its text changes
+    std::string labelText;
+    int labelW, labelH;
+#ifdef SUDOKU_STATS
+    bool showStats = false;
+    void renderStats(const SolverStats& stats);
+#endif
+
+    // Layout of the board being drawn, set by render()
+    int boxSize;
+    int gridSize;
+    int cellSize;
+    int gridPixels;
+    int gridStartX;
+
+    // Every board symbol in every style, rendered once into a single texture that
+    // cells, pencil marks and the tally blit from by source rect. Built on first
+    // use and again only after the fonts change (close() drops it).
+    enum class GlyphStyle {
+        Fixed,          // givens, also the tally's counts
+        User,
+        Conflict,
+        Tally,          // bold
+        TallyDone,      // bold, digit placed everywhere
+        Note,           // small font
+        Count
+    };
+    static const int MAX_GRID_SIZE = BasicSudoku<5>::GRID_SIZE;
+    static const int GLYPH_STYLES = static_cast<int>(GlyphStyle::Count);
+    static const int ATLAS_SYMBOLS = MAX_GRID_SIZE + 1;   // '0' for the counts, then digits 1..25
+
+    SDL_Texture* atlas;
+    TTF_Font* atlasFont;        // font the atlas was built from
+    SDL_Rect glyphRects[GLYPH_STYLES][ATLAS_SYMBOLS];
+
+    // Board digits and notes, and the tally row, are drawn into textures kept
+    // across frames. A layer redraws only the cells the board marks dirty, and
+    // nothing while the board version stands still; a version from another board
+    // (a new epoch) or a new layout redraws all of it. Dropped with the atlas.
+    struct Layer {
+        SDL_Texture* texture;
+        int w, h;
+        int gridSize;           // layout it was drawn for, 0 until the first full draw
+        uint64_t version;       // board version it shows
+    };
+    Layer boardLayer;
+    Layer tallyLayer;
+
+    void setLayout(int subgridSize);
+    void fitToCell(int& w, int& h) const;
 
     void renderGrid();
-    void renderNumbers(const Sudoku& sudoku);
-    void renderNumber(int number, int row, int col, bool isFixed, bool hasConflict);
+    template <int Box>
+    void renderNumbers(const BasicSudoku<Box>& sudoku);
+    template <int Box>
+    void renderCell(const BasicSudoku<Box>& sudoku, int row, int col, int x, int y);
+    void renderNumber(GlyphStyle style, int number, int x, int y);
+    void renderNotes(uint32_t notes, int x, int y);
     void renderSelectedCell(int row, int col);
-    void renderNumberCounts(const Sudoku& sudoku);
+    void renderHint();
+    template <int Box>
+    void renderNumberCounts(const BasicSudoku<Box>& sudoku);
+    template <int Box>
+    void renderTally(const BasicSudoku<Box>& sudoku, int x, int y);
+    bool prepareLayer(Layer& layer, int w, int h);
+    bool layerIsStale(const Layer& layer, uint64_t version) const;
+    void drawLayer(const Layer& layer, int x, int y);
+    void freeLayer(Layer& layer);
     void renderText(const std::string& text, int x, int y, SDL_Color color);
-    std::array<int, 9> calculateNumberCounts(const Sudoku& sudoku) const;
+    void renderRating();
+    bool buildAtlas();
+    void drawGlyph(GlyphStyle style, int symbol, const SDL_Rect& dstRect);   // symbol: 0 for '0', else a digit
+    void releaseCaches();
 
     static SDL_Texture *iconTexture;
 
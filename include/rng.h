@@ -0,0 +1,73 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <cstdint>
+#include <random>
+#include <utility>
+
+// xoshiro256** (Blackman & Vigna), seeded through splitmix64. Small, fast and fully
+// defined by its seed, so one seed rebuilds the same puzzle on every platform; the
+// helpers below avoid the std distributions, whose output is implementation-defined.
+class Rng {
+public:
+    using result_type = uint64_t;
+
+    explicit Rng(uint64_t seed = 0) { reseed(seed); }
+
+    void reseed(uint64_t seed) {
+        for (auto& word : state) word = splitmix64(seed);
+    }
+
+    uint64_t operator()() {
+        uint64_t result = rotl(state[1] * 5, 7) * 9;
+        uint64_t t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotl(state[3], 45);
+        return result;
+    }
+
+    static constexpr uint64_t min() { return 0; }
+    static constexpr uint64_t max() { return ~uint64_t(0); }
+
+    // Uniform in [0, n) by multiply-shift; the bias is far below anything a board can show
+    uint64_t below(uint64_t n) {
+        return static_cast<uint64_t>((static_cast<unsigned __int128>((*this)()) * n) >> 64);
+    }
+
+    // Fisher-Yates over [first, last)
+    template <typename It>
+    void shuffle(It first, It last) {
+        for (auto i = last - first; i > 1; i--) {
+            std::swap(first[i - 1], first[below(static_cast<uint64_t>(i))]);
+        }
+    }
+
+    static uint64_t splitmix64(uint64_t& x) {
+        uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    // A new nonzero seed (0 means "unknown" in puzzle records). Only the first call
+    // on each thread touches std::random_device; later ones are a splitmix64 step.
+    static uint64_t freshSeed() {
+        thread_local uint64_t source = (uint64_t(std::random_device{}()) << 32) ^ std::random_device{}();
+        uint64_t seed;
+        do {
+            seed = splitmix64(source);
+        } while (seed == 0);
+        return seed;
+    }
+
+private:
+    uint64_t state[4];
+
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+};
+
+#endif // RNG_H
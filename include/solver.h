@@ -0,0 +1,115 @@
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include <array>
+#include <cstdint>
+#include "sudoku_tables.h"
+#include "rng.h"
+#include "solver_stats.h"
+
+template <int Box>
+using BasicGrid = std::array<uint8_t, BasicSudokuTables<Box>::CELL_COUNT>;   // row-major digits, 0 = empty
+using SudokuGrid = BasicGrid<3>;
+
+enum class SolverEngine {
+    Backtracking,
+    DancingLinks,
+    Parallel        // backtracking split across threads, for single hard boards
+};
+
+// Common interface of the exact solvers
+template <int Box>
+class BasicSolver {
+public:
+    virtual ~BasicSolver() = default;
+
+    // Searches for up to `limit` solutions and returns how many were found.
+    // The first solution found is written back into `grid`; it is left untouched when there is none.
+    virtual int solve(BasicGrid<Box>& grid, int limit = 1) = 0;
+};
+
+using Solver = BasicSolver<3>;
+
+// Depth-first search that applies naked and hidden singles until nothing
+// changes, then branches on the empty cell with the fewest candidates.
+// Defined for Box = 3, 4 and 5 in solver.cpp.
+template <int Box>
+class BasicBacktrackingSolver : public BasicSolver<Box> {
+public:
+    using Tables = BasicSudokuTables<Box>;
+    using Grid = BasicGrid<Box>;
+    using Mask = typename Tables::Mask;
+
+    explicit BasicBacktrackingSolver(Rng* rng = nullptr);   // shuffles the value order when given an rng
+
+    int solve(Grid& grid, int limit = 1) override;
+
+    // Gives up after `nodes` branches (0 = never); check hitNodeLimit() before trusting a count
+    void setNodeLimit(uint64_t nodes) { nodeLimit = nodes; }
+    bool hitNodeLimit() const { return nodeLimit != 0 && nodeCount > nodeLimit; }
+
+    // Clue removal with incremental uniqueness checks. beginRemoval starts from a full
+    // solution; tryRemove empties `cells` only if the puzzle keeps that one solution,
+    // and counts a node limit hit as "not unique".
+    void beginRemoval(const Grid& solution);
+    bool tryRemove(const int* cells, int count);
+
+private:
+    template <int> friend class BasicParallelSolver;   // shares the state and the branching
+
+    struct State {
+        Grid grid;
+        std::array<Mask, Tables::CELL_COUNT> candidates;   // 0 once a cell is filled
+    };
+    struct Choice {
+        int cell;
+        int num;
+    };
+
+    // The puzzle so far: clues assigned, empty cells with their plain (unpropagated)
+    // candidates, so a removal only has to widen the masks around the emptied cells
+    State removalBase;
+    Grid removalSolution;
+
+    Rng* rng;
+    Grid* firstSolution;
+    int solutionLimit;
+    int solutionCount;
+    uint64_t nodeLimit;
+    uint64_t nodeCount;
+
+    static bool load(State& state, const Grid& grid);    // false when the givens clash
+    static int findBranch(const State& state, Choice* choices);   // -1 once the grid is full
+    static bool assign(State& state, int cell, int num);
+    static bool propagate(State& state);
+    static bool eliminateLocked(State& state, bool& changed);   // pointing and claiming, for big boards
+    bool search(State& state);
+};
+
+extern template class BasicBacktrackingSolver<3>;
+extern template class BasicBacktrackingSolver<4>;
+extern template class BasicBacktrackingSolver<5>;
+
+using BacktrackingSolver = BasicBacktrackingSolver<3>;
+
+// Per-thread engine instances, so callers never allocate a solver on the hot path.
+// Dancing links only covers 9x9; larger boards get the backtracker for it.
+Solver& getSolver(SolverEngine engine);
+
+template <int Box>
+BasicSolver<Box>& getParallelSolver();   // parallel_solver.cpp
+
+template <int Box>
+BasicSolver<Box>& getSolver(SolverEngine engine) {
+    if constexpr (Box == 3) {
+        return getSolver(engine);
+    } else {
+        if (engine == SolverEngine::Parallel) {
+            return getParallelSolver<Box>();
+        }
+        thread_local BasicBacktrackingSolver<Box> backtracking;
+        return backtracking;
+    }
+}
+
+#endif // SOLVER_H
@@ -0,0 +1,67 @@
+#ifndef SOLVER_STATS_H
+#define SOLVER_STATS_H
+
+#include <cstdint>
+
+// Work counters for the solvers and the generator. Only built with SUDOKU_STATS
+// defined (make STATS=1); otherwise the macros below expand to nothing and the
+// struct is never touched, so release builds pay nothing.
+struct SolverStats {
+    uint64_t nodes = 0;             // search() calls, either engine
+    uint64_t backtracks = 0;        // branches that led nowhere
+    uint64_t propagations = 0;      // digits placed by singles, without branching
+    uint64_t uniquenessChecks = 0;  // solution counts run by removeCells
+    uint64_t cellsRestored = 0;     // removals undone because the puzzle lost uniqueness
+    uint64_t fillMicros = 0;        // wall time filling solution grids
+    uint64_t removeMicros = 0;      // wall time removing clues
+    uint64_t solveMicros = 0;       // wall time in Sudoku::solve / countSolutions
+
+    SolverStats& operator+=(const SolverStats& other);
+    SolverStats operator-(const SolverStats& other) const;
+};
+
+#ifdef SUDOKU_STATS
+
+#include <chrono>
+
+// Running totals of the calling thread; boards keep the share of their own generation
+SolverStats& threadSolverStats();
+
+// Adds the wall time of its scope to one of the *Micros fields
+class StatsTimer {
+public:
+    explicit StatsTimer(uint64_t SolverStats::*field) : field(field), start(std::chrono::steady_clock::now()) {}
+    ~StatsTimer() {
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        threadSolverStats().*field += std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+    }
+
+private:
+    uint64_t SolverStats::*field;
+    std::chrono::steady_clock::time_point start;
+};
+
+// Stores the work done on this thread during its scope into `target`
+class StatsCapture {
+public:
+    explicit StatsCapture(SolverStats& target) : target(target), before(threadSolverStats()) {}
+    ~StatsCapture() { target = threadSolverStats() - before; }
+
+private:
+    SolverStats& target;
+    SolverStats before;
+};
+
+#define SUDOKU_STAT(field, n) (threadSolverStats().field += (n))
+#define SUDOKU_STAT_TIMER(field) StatsTimer statsTimer_##field(&SolverStats::field)
+#define SUDOKU_STAT_CAPTURE(target) StatsCapture statsCapture(target)
+
+#else
+
+#define SUDOKU_STAT(field, n) ((void)0)
+#define SUDOKU_STAT_TIMER(field) ((void)0)
+#define SUDOKU_STAT_CAPTURE(target) ((void)0)
+
+#endif // SUDOKU_STATS
+
+#endif // SOLVER_STATS_H
@@ -0,0 +1,54 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+// Bounded lock-free queue for exactly one producer thread and one consumer thread.
+// Items are moved with memcpy, so the slots never run T's constructor.
+template <typename T, size_t Capacity>
+class SpscRing {
+    static_assert(std::is_trivially_copyable<T>::value, "SpscRing copies items with memcpy");
+
+public:
+    SpscRing() : readIndex(0), writeIndex(0) {}
+
+    // Producer side
+    bool push(const T& item) {
+        size_t write = writeIndex.load(std::memory_order_relaxed);
+        size_t next = (write + 1) % SLOTS;
+        if (next == readIndex.load(std::memory_order_acquire)) {
+            return false; // full
+        }
+        std::memcpy(slots[write], &item, sizeof(T));
+        writeIndex.store(next, std::memory_order_release);
+        return true;
+    }
+
+    bool full() const {
+        size_t next = (writeIndex.load(std::memory_order_relaxed) + 1) % SLOTS;
+        return next == readIndex.load(std::memory_order_acquire);
+    }
+
+    // Consumer side
+    bool pop(T& item) {
+        size_t read = readIndex.load(std::memory_order_relaxed);
+        if (read == writeIndex.load(std::memory_order_acquire)) {
+            return false; // empty
+        }
+        std::memcpy(&item, slots[read], sizeof(T));
+        readIndex.store((read + 1) % SLOTS, std::memory_order_release);
+        return true;
+    }
+
+private:
+    static const size_t SLOTS = Capacity + 1;   // one slot stays free to tell full from empty
+
+    alignas(T) unsigned char slots[SLOTS][sizeof(T)];
+    alignas(64) std::atomic<size_t> readIndex;
+    alignas(64) std::atomic<size_t> writeIndex;
+};
+
+#endif // SPSC_RING_H
@@ -1,34 +1,166 @@
 #ifndef SUDOKU_H
 #define SUDOKU_H
 
+#include <array>
+#include <string>
 #include <vector>
-#include <random>
 #include <algorithm>
+#include <cstdint>
+#include <type_traits>
+#include "sudoku_tables.h"
+#include "solver.h"
+#include "rng.h"
 
-class Sudoku {
+struct PackedPuzzle;
+
+// Clue patterns a generated puzzle can keep: cells are removed together with their
+// image under a 180-degree turn or a left-right mirror of the board
+enum class Symmetry : uint8_t {
+    None,
+    Rotational,
+    Mirror
+};
+
+// Constructor tag for a board that starts empty, skipping the Medium puzzle the
+// default constructor generates (slow on 25x25) when one is loaded or generated next
+struct EmptyBoard {};
+
+// A board of Box x Box boxes (N = Box * Box digits). Sizes are fixed at compile
+// time so the masks and tables fit the board exactly; sudoku.cpp defines the
+// 9x9, 16x16 and 25x25 boards.
+template <int Box>
+class BasicSudoku {
 public:
-    static const int GRID_SIZE = 9;
-    static const int SUBGRID_SIZE = 3;
+    using Tables = BasicSudokuTables<Box>;
+    using Mask = typename Tables::Mask;
+    using Grid = BasicGrid<Box>;
+
+    static const int GRID_SIZE = Tables::GRID_SIZE;
+    static const int SUBGRID_SIZE = Tables::SUBGRID_SIZE;
+    static const int CELL_COUNT = Tables::CELL_COUNT;
+    static const int UNIT_COUNT = Tables::UNIT_COUNT;
 
-    Sudoku();
-    void generatePuzzle(int difficulty);
+    BasicSudoku();
+    explicit BasicSudoku(EmptyBoard);
+    void generatePuzzle(int difficulty);                  // from a fresh random seed
+    void generatePuzzle(int difficulty, uint64_t seed);   // the same seed always gives the same puzzle
+    bool generateFromId(const std::string& id);           // rebuilds the puzzle behind getPuzzleId()
+    bool loadPuzzle(const std::string& text);         // CELL_COUNT symbols (see digitSymbol), '.' or '0' empty
+    bool solve();                                     // fills the empty cells with the selected engine
     bool isValid(int row, int col, int num) const;
     bool isCellEditable(int row, int col) const;
     bool setNumber(int row, int col, int num);
     int getNumber(int row, int col) const;
-    bool isSolved() const;
-    bool hasConflict(int row, int col) const;
+    bool isSolved() const { return filledCount == CELL_COUNT && conflictCount == 0; }
+    bool hasConflict(int row, int col) const;         // shares its digit with a row, column or box peer
+    int getConflictCount() const { return conflictCount; }   // cells that have a conflict
+    int getDigitCount(int num) const { return digitTotal[num]; }   // cells holding num, repeats included
+
+    // Change tracking for views. The version moves on every edit and never repeats
+    // across boards in one process; dirty cells are those whose digit or conflict
+    // state changed since the last clearDirty() (a new board marks them all).
+    uint64_t getVersion() const { return version; }
+    bool isDirty(int row, int col) const;
+    void clearDirty() { std::fill(std::begin(dirtyBits), std::end(dirtyBits), 0); }
+    Grid getDigits() const;                           // digits only, without the given flags
+    std::string toString() const;                     // CELL_COUNT symbols row-major, '.' for empty cells
+    Mask getCandidates(int row, int col) const;       // bit (num - 1) set for every num that fits
+    int countCandidates(int row, int col) const;
+    int countSolutions(int limit = 2) const;           // stops counting once `limit` is reached
+
+    // Pencil marks: bit (num - 1) per noted digit, kept on editable cells only
+    Mask getNotes(int row, int col) const { return notes[cellIndex(row, col)]; }
+    bool setNotes(int row, int col, Mask digits);
+    bool toggleNote(int row, int col, int num);        // empty editable cells only
+    uint64_t clearPeerNotes(int row, int col, int num); // bit i set for each peers[cell][i] that lost num
+    void restorePeerNotes(int row, int col, int num, uint64_t peerBits);
+    void fillNotes();                                 // every empty cell gets its current candidates
+    void setSolverEngine(SolverEngine engine) { solverEngine = engine; }
+    SolverEngine getSolverEngine() const { return solverEngine; }
+    void setSymmetry(Symmetry pattern) { symmetry = pattern; }   // for the next generatePuzzle
+    Symmetry getSymmetry() const { return symmetry; }
+#ifdef SUDOKU_STATS
+    const SolverStats& getStats() const { return stats; }   // work behind the last generatePuzzle or solve
+#endif
+
+    // Where the current puzzle came from; seed 0 for puzzles that were loaded, not generated
+    uint64_t getSeed() const { return puzzleSeed; }
+    int getDifficulty() const { return puzzleDifficulty; }
+    Symmetry getPuzzleSymmetry() const { return puzzleSymmetry; }
+    std::string getPuzzleId() const;    // "2-0J8CXM4T5QW1R" (difficulty, seed in base32); NxN- prefix past 9x9,
+                                        // R or M after the difficulty for symmetric puzzles
+
+    // The puzzle bank stores 9x9 boards only
+    template <int B = Box, typename = std::enable_if_t<B == 3>>
+    void loadPacked(const PackedPuzzle& puzzle);       // straight from a mapped puzzle bank record
+    template <int B = Box, typename = std::enable_if_t<B == 3>>
+    PackedPuzzle pack(int difficulty) const;
+
+    // '1'-'9', then 'A' for 10, 'B' for 11 and so on
+    static char digitSymbol(int num) { return static_cast<char>(num < 10 ? '0' + num : 'A' + num - 10); }
+    static int symbolDigit(char c);                   // 0 for anything that is not a digit of this board
 
 private:
-    std::vector<std::vector<int>> grid; // 9x9 grid
-    std::vector<std::vector<bool>> fixed; // the given cells uneditable
-    
-    bool solveGrid();
+    static const uint8_t VALUE_MASK = 0x3F;
+    static const uint8_t FIXED_FLAG = 0x80;   // the given cells uneditable
+    static const int MAX_GENERATE_ATTEMPTS = 4;
+    static const int UNIQUENESS_NODE_LIMIT = 200;   // search budget per removal check on big boards
+
+    std::array<uint8_t, CELL_COUNT> cells;    // row-major, digit in the low bits
+
+    // Digit masks per unit: bit (num - 1) is set while num is placed in that row/col/box
+    Mask rowMask[GRID_SIZE];
+    Mask colMask[GRID_SIZE];
+    Mask boxMask[GRID_SIZE];
+
+    // Occurrences of each digit per unit (rows, then cols, then boxes, as in the
+    // tables) and the cells whose digit appears twice in some unit. Every edit
+    // keeps them current, so the conflict and solved queries are plain reads.
+    uint8_t digitCount[UNIT_COUNT][GRID_SIZE + 1];
+    uint64_t conflictBits[(CELL_COUNT + 63) / 64];
+    int conflictCount;
+    int filledCount;
+    uint16_t digitTotal[GRID_SIZE + 1];
+    uint64_t version;
+    uint64_t dirtyBits[(CELL_COUNT + 63) / 64];
+    Mask notes[CELL_COUNT];
+#ifdef SUDOKU_STATS
+    SolverStats stats;
+#endif
+
+    SolverEngine solverEngine;
+    Symmetry symmetry;
+    uint64_t puzzleSeed;
+    int puzzleDifficulty;
+    Symmetry puzzleSymmetry;
+
+    static constexpr const Tables& tables() { return BASIC_SUDOKU_TABLES<Box>; }
+    static int cellIndex(int row, int col) { return row * GRID_SIZE + col; }
+    static Mask digitBit(int num) { return static_cast<Mask>(Mask(1) << (num - 1)); }
+
+    Mask usedDigits(int cell) const;
+    void placeDigit(int cell, int num);
+    void clearDigit(int cell);
+    void markDirty(int cell) { version++; dirtyBits[cell / 64] |= uint64_t(1) << (cell % 64); }
+    void refreshConflict(int cell);
+    void refreshConflicts(int cell, int num);
+
+    void clearBoard();
+    void fillSolutionGrid(Rng& rng);
+    bool solveGrid(Rng& rng);
+    void fillEmptyCells(const Grid& solution);
     bool findEmptyCell(int &row, int &col) const;
-    void removeCells(int cellsToRemove);
-    bool isValidInRow(int row, int num) const;
-    bool isValidInCol(int col, int num) const;
-    bool isValidInBox(int startRow, int startCol, int num) const;
+    int removeCells(int cellsToRemove, Rng& rng);   // returns how many cells were blanked
+    int symmetricGroup(int cell, int* group) const; // the cell and its image under `symmetry`, 1 or 2 cells
 };
 
-#endif // SUDOKU_H
\ No newline at end of file
+extern template class BasicSudoku<3>;
+extern template class BasicSudoku<4>;
+extern template class BasicSudoku<5>;
+
+using Sudoku = BasicSudoku<3>;
+
+// Boards are copied by value (Game resets with `sudoku = Sudoku()`), so keep them memcpy-able
+static_assert(std::is_trivially_copyable<Sudoku>::value, "Sudoku must stay trivially copyable");
+
+#endif // SUDOKU_H
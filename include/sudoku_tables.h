@@ -0,0 +1,87 @@
+#ifndef SUDOKU_TABLES_H
+#define SUDOKU_TABLES_H
+
+#include <cstdint>
+#include <type_traits>
+
+// Narrowest unsigned type with one bit per digit
+template <int Digits>
+using DigitMask = std::conditional_t<(Digits <= 16), uint16_t,
+                  std::conditional_t<(Digits <= 32), uint32_t, uint64_t>>;
+
+// Narrowest unsigned type that can index every cell
+template <int Cells>
+using CellIndex = std::conditional_t<(Cells <= 256), uint8_t, uint16_t>;
+
+// Compile-time lookup tables for a board of Box x Box boxes, indexed by flat cell index (row * N + col)
+template <int Box>
+struct BasicSudokuTables {
+    static_assert(Box >= 2 && Box <= 7, "digit masks are at most 64 bits wide");
+
+    static const int SUBGRID_SIZE = Box;
+    static const int GRID_SIZE = Box * Box;
+    static const int CELL_COUNT = GRID_SIZE * GRID_SIZE;
+    static const int UNIT_COUNT = GRID_SIZE * 3;                         // N rows, N cols, N boxes
+    static const int PEER_COUNT = 2 * (GRID_SIZE - 1) + (Box - 1) * (Box - 1);   // row + col + rest of box
+
+    using Mask = DigitMask<GRID_SIZE>;
+    using Index = CellIndex<CELL_COUNT>;
+    static constexpr Mask ALL_DIGITS = static_cast<Mask>(~uint64_t(0) >> (64 - GRID_SIZE));
+
+    uint8_t rowOf[CELL_COUNT];
+    uint8_t colOf[CELL_COUNT];
+    uint8_t boxOf[CELL_COUNT];
+    Index peers[CELL_COUNT][PEER_COUNT];
+    Index units[UNIT_COUNT][GRID_SIZE];          // cells of rows 0..N-1, then cols, then boxes
+};
+
+template <int Box>
+constexpr BasicSudokuTables<Box> makeSudokuTables() {
+    using Tables = BasicSudokuTables<Box>;
+    using Index = typename Tables::Index;
+    Tables t{};
+    const int N = Tables::GRID_SIZE;
+    const int B = Tables::SUBGRID_SIZE;
+
+    for (int cell = 0; cell < Tables::CELL_COUNT; cell++) {
+        int row = cell / N;
+        int col = cell % N;
+        t.rowOf[cell] = static_cast<uint8_t>(row);
+        t.colOf[cell] = static_cast<uint8_t>(col);
+        t.boxOf[cell] = static_cast<uint8_t>((row / B) * B + col / B);
+    }
+
+    for (int i = 0; i < N; i++) {
+        for (int j = 0; j < N; j++) {
+            t.units[i][j] = static_cast<Index>(i * N + j);
+            t.units[N + i][j] = static_cast<Index>(j * N + i);
+            t.units[2 * N + i][j] = static_cast<Index>(((i / B) * B + j / B) * N + (i % B) * B + j % B);
+        }
+    }
+
+    for (int cell = 0; cell < Tables::CELL_COUNT; cell++) {
+        int count = 0;
+        for (int other = 0; other < Tables::CELL_COUNT; other++) {
+            if (other == cell) continue;
+            if (t.rowOf[other] == t.rowOf[cell] || t.colOf[other] == t.colOf[cell] || t.boxOf[other] == t.boxOf[cell]) {
+                t.peers[cell][count++] = static_cast<Index>(other);
+            }
+        }
+    }
+    return t;
+}
+
+template <int Box>
+inline constexpr BasicSudokuTables<Box> BASIC_SUDOKU_TABLES = makeSudokuTables<Box>();
+
+// The classic 9x9 board
+using SudokuTables = BasicSudokuTables<3>;
+inline constexpr const SudokuTables& SUDOKU_TABLES = BASIC_SUDOKU_TABLES<3>;
+
+static_assert(SudokuTables::PEER_COUNT == 20, "8 in row + 8 in col + 4 more in box");
+static_assert(SUDOKU_TABLES.peers[0][19] == 72, "last peer of cell 0 should be (8,0)");
+static_assert(SUDOKU_TABLES.boxOf[80] == 8, "box table out of order");
+static_assert(std::is_same<SudokuTables::Mask, uint16_t>::value && SudokuTables::ALL_DIGITS == 0x1FF,
+              "9x9 masks must stay 16-bit");
+
+#endif // SUDOKU_TABLES_H
@@ -0,0 +1,233 @@
+#include "batch_solver.h"
+#include <algorithm>
+
+namespace {
+
+// GCC/Clang vector extensions: element-wise operators, one puzzle per lane
+typedef uint16_t Lanes8 __attribute__((vector_size(16)));
+typedef uint16_t Lanes16 __attribute__((vector_size(32)));
+
+const uint16_t ALL_DIGITS = 0x1FF;
+
+template <typename V>
+inline __attribute__((always_inline)) bool anyLane(const V& v) {
+    bool any = false;
+    for (unsigned lane = 0; lane < sizeof(V) / sizeof(uint16_t); lane++) {
+        any |= v[lane] != 0;
+    }
+    return any;
+}
+
+// Locked candidates, lane-wise like BacktrackingSolver::eliminateLocked: a digit
+// confined to one line of a box leaves the rest of that line (pointing), and one
+// confined to one box of a line leaves the rest of that box (claiming). Sets
+// `diff` to the bits that changed; emptied cells are left for the caller to find.
+template <typename V>
+inline __attribute__((always_inline)) void eliminateLockedLanes(V* candidates, V& diff) {
+    const int N = SudokuTables::GRID_SIZE;
+    const int BOX = SudokuTables::SUBGRID_SIZE;
+    const auto& tables = SUDOKU_TABLES;
+    diff = V{};
+    auto strip = [candidates, &diff](int cell, const V& digits) {
+        V before = candidates[cell];
+        V after = before & ~digits;
+        candidates[cell] = after;
+        diff |= before ^ after;
+    };
+
+    for (int box = 0; box < N; box++) {
+        V rowPart[BOX] = {}, colPart[BOX] = {};
+        for (int j = 0; j < N; j++) {
+            V c = candidates[tables.units[2 * N + box][j]];
+            rowPart[j / BOX] |= c;
+            colPart[j % BOX] |= c;
+        }
+        for (int i = 0; i < BOX; i++) {
+            V otherRows = {}, otherCols = {};
+            for (int k = 0; k < BOX; k++) {
+                if (k == i) continue;
+                otherRows |= rowPart[k];
+                otherCols |= colPart[k];
+            }
+            V rowLocked = rowPart[i] & ~otherRows;
+            V colLocked = colPart[i] & ~otherCols;
+            int row = (box / BOX) * BOX + i;
+            int col = (box % BOX) * BOX + i;
+            for (int j = 0; j < N; j++) {
+                if (j / BOX != box % BOX) strip(tables.units[row][j], rowLocked);
+                if (j / BOX != box / BOX) strip(tables.units[N + col][j], colLocked);
+            }
+        }
+    }
+
+    for (int line = 0; line < 2 * N; line++) {
+        V segment[BOX] = {};
+        for (int j = 0; j < N; j++) {
+            segment[j / BOX] |= candidates[tables.units[line][j]];
+        }
+        bool isRow = line < N;
+        int index = isRow ? line : line - N;
+        for (int k = 0; k < BOX; k++) {
+            V others = {};
+            for (int m = 0; m < BOX; m++) {
+                if (m != k) others |= segment[m];
+            }
+            V locked = segment[k] & ~others;
+            int box = isRow ? (index / BOX) * BOX + k : k * BOX + index / BOX;
+            for (int j = 0; j < N; j++) {
+                int cell = tables.units[2 * N + box][j];
+                bool onLine = isRow ? tables.rowOf[cell] == index : tables.colOf[cell] == index;
+                if (!onLine) strip(cell, locked);
+            }
+        }
+    }
+}
+
+// Runs naked and hidden singles over every lane until no lane changes, then
+// locked candidates whenever singles stall. Solved cells keep their single
+// bit, so a lane is dead once any cell reaches 0 or a unit loses a digit entirely.
+template <typename V>
+inline __attribute__((always_inline)) void propagateLanes(V* candidates, V& dead) {
+    const V zero = {};
+    bool changed = true;
+    while (changed) {
+        V diff = zero;
+
+        // Naked singles: strip a single's digit from its 20 peers
+        for (int cell = 0; cell < SudokuTables::CELL_COUNT; cell++) {
+            V c = candidates[cell];
+            V isSingle = (V)((c & (c - 1)) == 0);
+            V singles = c & isSingle;
+            for (uint8_t peer : SUDOKU_TABLES.peers[cell]) {
+                V before = candidates[peer];
+                V after = before & ~singles;
+                candidates[peer] = after;
+                diff |= before ^ after;
+            }
+        }
+
+        // Hidden singles: a digit with one place left in a unit
+        for (const auto& unit : SUDOKU_TABLES.units) {
+            V once = zero, twice = zero;
+            for (uint8_t cell : unit) {
+                twice |= once & candidates[cell];
+                once |= candidates[cell];
+            }
+            dead |= (V)(once != ALL_DIGITS);
+
+            V hidden = once & ~twice;
+            for (uint8_t cell : unit) {
+                V before = candidates[cell];
+                V only = before & hidden;
+                V hasOnly = (V)(only != 0);
+                V after = (hasOnly & only) | (~hasOnly & before);
+                candidates[cell] = after;
+                diff |= before ^ after;
+            }
+        }
+
+        for (int cell = 0; cell < SudokuTables::CELL_COUNT; cell++) {
+            dead |= (V)(candidates[cell] == 0);
+        }
+
+        // Keep going while some live lane still moves
+        changed = anyLane(diff & ~dead);
+        if (!changed) {
+            eliminateLockedLanes(candidates, diff);
+            for (int cell = 0; cell < SudokuTables::CELL_COUNT; cell++) {
+                dead |= (V)(candidates[cell] == 0);
+            }
+            changed = anyLane(diff & ~dead);
+        }
+    }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SUDOKU_HAVE_AVX2_KERNEL 1
+
+// The always_inline kernel is compiled for AVX2 only inside this function
+__attribute__((target("avx2"))) void propagateAvx2(Lanes16* candidates, Lanes16& dead) {
+    propagateLanes(candidates, dead);
+}
+#endif
+
+void propagatePortable(Lanes8* candidates, Lanes8& dead) {
+    propagateLanes(candidates, dead);
+}
+
+void propagate(Lanes8* candidates, Lanes8& dead) { propagatePortable(candidates, dead); }
+
+#ifdef SUDOKU_HAVE_AVX2_KERNEL
+void propagate(Lanes16* candidates, Lanes16& dead) { propagateAvx2(candidates, dead); }
+#endif
+
+template <typename V>
+void solveLanes(SudokuGrid* grids, bool* solved, int count, uint64_t& vectorSolved, uint64_t& scalarFallbacks) {
+    const int LANES = sizeof(V) / sizeof(uint16_t);
+    V candidates[SudokuTables::CELL_COUNT];
+
+    // Interleave: lane i holds puzzle i; unused lanes repeat puzzle 0 and are ignored
+    for (int cell = 0; cell < SudokuTables::CELL_COUNT; cell++) {
+        for (int lane = 0; lane < LANES; lane++) {
+            uint8_t num = grids[lane < count ? lane : 0][cell];
+            candidates[cell][lane] = num ? static_cast<uint16_t>(1u << (num - 1)) : ALL_DIGITS;
+        }
+    }
+
+    V dead = {};
+    propagate(candidates, dead);
+
+    // Lanes that need branching continue one by one on the scalar engine
+    Solver& fallback = getSolver(SolverEngine::Backtracking);
+    for (int lane = 0; lane < count; lane++) {
+        solved[lane] = false;
+        if (dead[lane]) continue;
+
+        SudokuGrid deduced;
+        bool complete = true;
+        for (int cell = 0; cell < SudokuTables::CELL_COUNT; cell++) {
+            uint16_t c = candidates[cell][lane];
+            bool single = (c & (c - 1)) == 0;
+            deduced[cell] = single ? static_cast<uint8_t>(__builtin_ctz(c) + 1) : 0;
+            complete &= single;
+        }
+
+        if (complete) {
+            vectorSolved++;
+        } else {
+            scalarFallbacks++;
+            if (fallback.solve(deduced) == 0) continue;
+        }
+        grids[lane] = deduced;
+        solved[lane] = true;
+    }
+}
+
+} // namespace
+
+BatchSolver::BatchSolver(Kernel kernel) : kernel(kernel), vectorSolved(0), scalarFallbacks(0) {
+    if (this->kernel == Kernel::Auto || (this->kernel == Kernel::Avx2 && !hasAvx2())) {
+        this->kernel = hasAvx2() ? Kernel::Avx2 : Kernel::Portable;
+    }
+}
+
+bool BatchSolver::hasAvx2() {
+#ifdef SUDOKU_HAVE_AVX2_KERNEL
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
+
+void BatchSolver::solve(SudokuGrid* grids, bool* solved, int count) {
+    count = std::min(count, getLanes());
+    if (count <= 0) return;
+
+#ifdef SUDOKU_HAVE_AVX2_KERNEL
+    if (kernel == Kernel::Avx2) {
+        solveLanes<Lanes16>(grids, solved, count, vectorSolved, scalarFallbacks);
+        return;
+    }
+#endif
+    solveLanes<Lanes8>(grids, solved, count, vectorSolved, scalarFallbacks);
+}
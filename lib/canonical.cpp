@@ -0,0 +1,214 @@
+#include "canonical.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+namespace {
+
+const int N = SudokuTables::GRID_SIZE;
+
+const uint8_t PERMS[6][3] = {{0, 1, 2}, {0, 2, 1}, {1, 0, 2}, {1, 2, 0}, {2, 0, 1}, {2, 1, 0}};
+
+// Indexed by output column, each entry is a source column
+using ColumnOrder = std::array<uint8_t, SudokuTables::GRID_SIZE>;
+
+// One transform with its first rows chosen. The column order and transposition
+// are fixed from the start; digits get labels as the output reaches them.
+struct Partial {
+    ColumnOrder cols;
+    uint8_t labels[N + 1];      // source digit -> output digit, 0 while unassigned
+    uint8_t nextLabel;
+    uint8_t transposed;
+    uint8_t band;               // source band of the last chosen row
+    uint16_t rowsUsed;          // bit per source row
+};
+
+// The first output row gets fresh labels, so its digits read 1, 2, 3... whatever
+// the transform and only its pattern of empty cells matters. The smallest row
+// pushes its clues right: stacks with fewer clues first, empty cells first in
+// each stack. Only the source rows that reach the smallest pattern and the
+// column orders that produce it start a candidate, instead of all 2 x 9 x 1296.
+void seedFirstRow(const SudokuGrid (&sources)[2], std::vector<Partial>& seeds, uint8_t* firstRow) {
+    auto patternOf = [](const uint8_t* cells) {
+        int counts[3];
+        for (int stack = 0; stack < 3; stack++) {
+            counts[stack] = (cells[stack * 3] != 0) + (cells[stack * 3 + 1] != 0) + (cells[stack * 3 + 2] != 0);
+        }
+        std::sort(counts, counts + 3);
+        int pattern = 0;   // bit 8 - col set for a clue in output column col
+        for (int stack = 0; stack < 3; stack++) {
+            pattern = (pattern << 3) | ((1 << counts[stack]) - 1);
+        }
+        return pattern;
+    };
+
+    int best = 1 << N;
+    for (int transposed = 0; transposed < 2; transposed++) {
+        for (int source = 0; source < N; source++) {
+            best = std::min(best, patternOf(&sources[transposed][source * N]));
+        }
+    }
+
+    for (uint8_t transposed = 0; transposed < 2; transposed++) {
+        for (int source = 0; source < N; source++) {
+            const uint8_t* cells = &sources[transposed][source * N];
+            if (patternOf(cells) != best) continue;
+
+            auto filled = [cells](int col) { return cells[col] != 0 ? 1 : 0; };
+            auto stackCount = [&filled](int stack) { return filled(stack * 3) + filled(stack * 3 + 1) + filled(stack * 3 + 2); };
+
+            // Orders within each stack that put its empty cells first
+            std::vector<const uint8_t*> within[3];
+            for (int stack = 0; stack < 3; stack++) {
+                for (const auto& perm : PERMS) {
+                    int base = stack * 3;
+                    if (filled(base + perm[0]) <= filled(base + perm[1]) && filled(base + perm[1]) <= filled(base + perm[2])) {
+                        within[stack].push_back(perm);
+                    }
+                }
+            }
+
+            for (const auto& stacks : PERMS) {
+                if (stackCount(stacks[0]) > stackCount(stacks[1]) || stackCount(stacks[1]) > stackCount(stacks[2])) continue;
+                for (const uint8_t* first : within[stacks[0]]) {
+                    for (const uint8_t* second : within[stacks[1]]) {
+                        for (const uint8_t* third : within[stacks[2]]) {
+                            const uint8_t* inner[3] = {first, second, third};
+                            Partial seed = {};
+                            seed.nextLabel = 1;
+                            seed.transposed = transposed;
+                            seed.band = static_cast<uint8_t>(source / 3);
+                            seed.rowsUsed = static_cast<uint16_t>(1 << source);
+                            for (int col = 0; col < N; col++) {
+                                seed.cols[col] = static_cast<uint8_t>(stacks[col / 3] * 3 + inner[col / 3][col % 3]);
+                                int num = cells[seed.cols[col]];
+                                if (num != 0) {
+                                    if (seed.labels[num] == 0) seed.labels[num] = seed.nextLabel++;
+                                    num = seed.labels[num];
+                                }
+                                firstRow[col] = static_cast<uint8_t>(num);
+                            }
+                            seeds.push_back(seed);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+} // namespace
+
+SudokuGrid canonicalForm(const SudokuGrid& puzzle) {
+    SudokuGrid sources[2];
+    sources[0] = puzzle;
+    for (int cell = 0; cell < SudokuTables::CELL_COUNT; cell++) {
+        sources[1][cell] = puzzle[(cell % N) * N + cell / N];
+    }
+
+    SudokuGrid result{};
+    std::vector<Partial> current;
+    std::vector<Partial> next;
+    seedFirstRow(sources, current, &result[0]);
+
+    // Fill the remaining rows one at a time. A source row may start a band only if none of
+    // its band is used yet, and must stay in the band otherwise; every candidate
+    // whose row comes out bigger than the best so far is dropped on the spot.
+    for (int row = 1; row < N; row++) {
+        uint8_t* best = &result[row * N];
+        bool haveBest = false;
+        next.clear();
+        for (const Partial& partial : current) {
+            for (int source = 0; source < N; source++) {
+                int band = source / 3;
+                if (partial.rowsUsed & (1 << source)) continue;
+                if (row % 3 == 0 ? (partial.rowsUsed >> (band * 3)) & 7 : band != partial.band) continue;
+
+                Partial extended = partial;
+                const uint8_t* cells = &sources[partial.transposed][source * N];
+                uint8_t out[N];
+                int order = haveBest ? 0 : -1;   // vs best: 0 equal so far, -1 already smaller
+                for (int col = 0; col < N; col++) {
+                    int num = cells[extended.cols[col]];
+                    if (num != 0) {
+                        if (extended.labels[num] == 0) extended.labels[num] = extended.nextLabel++;
+                        num = extended.labels[num];
+                    }
+                    out[col] = static_cast<uint8_t>(num);
+                    if (order == 0 && out[col] != best[col]) {
+                        order = out[col] < best[col] ? -1 : 1;
+                        if (order > 0) break;
+                    }
+                }
+                if (order > 0) continue;
+
+                if (order < 0) {
+                    std::memcpy(best, out, N);
+                    haveBest = true;
+                    next.clear();
+                }
+                extended.rowsUsed = static_cast<uint16_t>(partial.rowsUsed | (1 << source));
+                extended.band = static_cast<uint8_t>(band);
+                next.push_back(extended);
+            }
+        }
+        current.swap(next);
+    }
+    return result;
+}
+
+uint64_t canonicalHash(const SudokuGrid& puzzle) {
+    SudokuGrid canonical = canonicalForm(puzzle);
+
+    // FNV-1a over the cells, then the splitmix64 finalizer to spread the low bits
+    // that CanonicalIndex probes with
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for (uint8_t num : canonical) {
+        hash = (hash ^ num) * 0x100000001B3ull;
+    }
+    hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ull;
+    hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBull;
+    hash ^= hash >> 31;
+    return hash != 0 ? hash : 1;
+}
+
+CanonicalIndex::CanonicalIndex(size_t expected) : count(0) {
+    size_t capacity = 1024;
+    while (capacity < expected * 2) capacity *= 2;
+    slots.assign(capacity, 0);
+}
+
+size_t CanonicalIndex::find(uint64_t hash) const {
+    size_t mask = slots.size() - 1;
+    size_t slot = hash & mask;
+    while (slots[slot] != 0 && slots[slot] != hash) {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+bool CanonicalIndex::contains(uint64_t hash) const {
+    if (hash == 0) hash = 1;
+    return slots[find(hash)] == hash;
+}
+
+bool CanonicalIndex::insert(uint64_t hash) {
+    if (hash == 0) hash = 1;   // canonicalHash never gives 0, keep it for free slots
+    size_t slot = find(hash);
+    if (slots[slot] == hash) {
+        return false;
+    }
+    slots[slot] = hash;
+    if (++count * 2 > slots.size()) {
+        grow();
+    }
+    return true;
+}
+
+void CanonicalIndex::grow() {
+    std::vector<uint64_t> old(slots.size() * 2, 0);
+    old.swap(slots);
+    for (uint64_t hash : old) {
+        if (hash != 0) slots[find(hash)] = hash;
+    }
+}
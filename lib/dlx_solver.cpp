@@ -0,0 +1,158 @@
+#include "dlx_solver.h"
+
+DlxSolver::DlxSolver() : depth(0), solutionLimit(1), solutionCount(0), firstSolution(nullptr) {
+    // Column headers and the root form one circular list
+    for (int c = 0; c <= COLUMNS; c++) {
+        Node& header = nodes[c];
+        header.left = static_cast<int16_t>(c == 0 ? COLUMNS : c - 1);
+        header.right = static_cast<int16_t>(c == COLUMNS ? 0 : c + 1);
+        header.up = header.down = static_cast<int16_t>(c);
+        header.column = static_cast<int16_t>(c);
+        header.row = -1;
+        columnSize[c] = 0;
+    }
+
+    // Every (cell, digit) row satisfies exactly four constraints
+    const int CELLS = SudokuTables::CELL_COUNT;
+    for (int row = 0; row < ROWS; row++) {
+        int cell = row / N;
+        int digit = row % N;
+        const int columns[4] = {
+            1 + cell,
+            1 + CELLS + SUDOKU_TABLES.rowOf[cell] * N + digit,
+            1 + 2 * CELLS + SUDOKU_TABLES.colOf[cell] * N + digit,
+            1 + 3 * CELLS + SUDOKU_TABLES.boxOf[cell] * N + digit
+        };
+
+        int first = rowNode(row);
+        for (int k = 0; k < 4; k++) {
+            int node = first + k;
+            int column = columns[k];
+            nodes[node].left = static_cast<int16_t>(first + (k + 3) % 4);
+            nodes[node].right = static_cast<int16_t>(first + (k + 1) % 4);
+
+            // Append at the bottom of the column
+            nodes[node].up = nodes[column].up;
+            nodes[node].down = static_cast<int16_t>(column);
+            nodes[nodes[column].up].down = static_cast<int16_t>(node);
+            nodes[column].up = static_cast<int16_t>(node);
+
+            nodes[node].column = static_cast<int16_t>(column);
+            nodes[node].row = static_cast<int16_t>(row);
+            columnSize[column]++;
+        }
+    }
+}
+
+int DlxSolver::solve(SudokuGrid& grid, int limit) {
+    solutionLimit = limit;
+    solutionCount = 0;
+    firstSolution = &grid;
+    depth = 0;
+
+    // Select the rows of the givens up front
+    std::array<int16_t, SudokuTables::CELL_COUNT> givens;
+    int givenCount = 0;
+    bool consistent = true;
+    for (int cell = 0; cell < SudokuTables::CELL_COUNT && consistent; cell++) {
+        if (grid[cell] == 0) continue;
+
+        int first = rowNode(cell * N + grid[cell] - 1);
+        for (int k = 0; k < 4; k++) {
+            // A constraint that is already covered means two givens clash
+            int column = nodes[first + k].column;
+            if (nodes[nodes[column].left].right != column) {
+                consistent = false;
+            }
+        }
+        if (!consistent) break;
+
+        for (int k = 0; k < 4; k++) {
+            cover(nodes[first + k].column);
+        }
+        givens[givenCount++] = static_cast<int16_t>(first);
+    }
+
+    if (consistent) {
+        search();
+    }
+
+    // Put the arena back the way the constructor left it
+    while (givenCount > 0) {
+        int first = givens[--givenCount];
+        for (int k = 3; k >= 0; k--) {
+            uncover(nodes[first + k].column);
+        }
+    }
+    return solutionCount;
+}
+
+void DlxSolver::cover(int column) {
+    Node& header = nodes[column];
+    nodes[header.right].left = header.left;
+    nodes[header.left].right = header.right;
+
+    for (int i = header.down; i != column; i = nodes[i].down) {
+        for (int j = nodes[i].right; j != i; j = nodes[j].right) {
+            nodes[nodes[j].down].up = nodes[j].up;
+            nodes[nodes[j].up].down = nodes[j].down;
+            columnSize[nodes[j].column]--;
+        }
+    }
+}
+
+void DlxSolver::uncover(int column) {
+    Node& header = nodes[column];
+    for (int i = header.up; i != column; i = nodes[i].up) {
+        for (int j = nodes[i].left; j != i; j = nodes[j].left) {
+            columnSize[nodes[j].column]++;
+            nodes[nodes[j].down].up = static_cast<int16_t>(j);
+            nodes[nodes[j].up].down = static_cast<int16_t>(j);
+        }
+    }
+
+    nodes[header.right].left = static_cast<int16_t>(column);
+    nodes[header.left].right = static_cast<int16_t>(column);
+}
+
+bool DlxSolver::search() {
+    SUDOKU_STAT(nodes, 1);
+    if (nodes[ROOT].right == ROOT) {
+        if (++solutionCount == 1) {
+            for (int i = 0; i < depth; i++) {
+                (*firstSolution)[chosen[i] / N] = static_cast<uint8_t>(chosen[i] % N + 1);
+            }
+        }
+        return solutionCount >= solutionLimit;
+    }
+
+    // Branch on the constraint with the fewest remaining options
+    int best = nodes[ROOT].right;
+    for (int c = nodes[best].right; c != ROOT && columnSize[best] > 1; c = nodes[c].right) {
+        if (columnSize[c] < columnSize[best]) {
+            best = c;
+        }
+    }
+    if (columnSize[best] == 0) {
+        return false;
+    }
+
+    cover(best);
+    bool done = false;
+    for (int r = nodes[best].down; r != best && !done; r = nodes[r].down) {
+        chosen[depth++] = nodes[r].row;
+        for (int j = nodes[r].right; j != r; j = nodes[j].right) {
+            cover(nodes[j].column);
+        }
+
+        done = search();
+        if (!done) SUDOKU_STAT(backtracks, 1);
+
+        for (int j = nodes[r].left; j != r; j = nodes[j].left) {
+            uncover(nodes[j].column);
+        }
+        depth--;
+    }
+    uncover(best);
+    return done;
+}
@@ -1,25 +1,38 @@
 #include "game.h"
 #include "renderer.h"
 #include <SDL2/SDL.h>
+#include <chrono>
+#include <cstdio>
 
-int Game::currentElapsedSeconds = 0;
+template <int Box>
+int BasicGame<Box>::currentElapsedSeconds = 0;
 
-Game::Game() : running(false), state(GameState::MENU), selectedRow(-1), selectedCol(-1), elapsedSeconds(0), startTime(0) {
+template <int Box>
+BasicGame<Box>::BasicGame() : sudoku(EmptyBoard()), solution{}, hasSolution(false), pencilMode(false), running(false), state(GameState::MENU), selectedRow(-1), selectedCol(-1), elapsedSeconds(0), startTime(0) {
     difficulty = 2; // default Medium
 }
 
-Game::~Game() {}
+template <int Box>
+BasicGame<Box>::~BasicGame() {}
 
-bool Game::init() {
+template <int Box>
+bool BasicGame<Box>::init() {
     if (!renderer.init()) {
         return false;
     }
     running = true;
     startTime = SDL_GetTicks();
+    // A prebuilt bank (make sudoku-gen, --db) replaces in-process generation
+    if (Box == 3 && puzzleBank.open("../puzzles.db")) {
+        bankRng.reseed(Rng::freshSeed());
+    } else {
+        puzzlePool.start();
+    }
     return true;
 }
 
-void Game::run() {
+template <int Box>
+void BasicGame<Box>::run() {
     while (running) {
         handleEvents();
         if (state == GameState::PLAYING) {
@@ -32,14 +45,18 @@ void Game::run() {
                 renderer.renderDifficultyScreen();
             } else if (state == GameState::PLAYING) {
                 renderer.render(sudoku, selectedRow, selectedCol);
+                sudoku.clearDirty();    // the renderer has picked up this frame's changes
             }
             SDL_Delay(16); // Cap at ~60 FPS
         }
     }
+    puzzlePool.stop();
     renderer.close();
+    reportLatency();
 }
 
-bool Game::handleMenuClick(int x, int y) {
+template <int Box>
+bool BasicGame<Box>::handleMenuClick(int x, int y) {
     if (renderer.handleMenuClick(x, y)) {
         state = GameState::DIFFICULTY;
         return true;
@@ -47,7 +64,8 @@ bool Game::handleMenuClick(int x, int y) {
     return false;
 }
 
-void Game::handleEvents() {
+template <int Box>
+void BasicGame<Box>::handleEvents() {
     SDL_Event event;
     while (SDL_PollEvent(&event)) {
         switch (event.type) {
@@ -62,7 +80,7 @@ void Game::handleEvents() {
             case SDL_KEYDOWN:
                 // Enable reset puzzle anytime while playing
                 if (state == GameState::PLAYING && event.key.keysym.sym == SDLK_r) {
-                    sudoku.generatePuzzle(difficulty);
+                    loadNewPuzzle();
                     startTime = SDL_GetTicks();
                     elapsedSeconds = 0;
                     currentElapsedSeconds = 0;
@@ -76,7 +94,8 @@ void Game::handleEvents() {
     }
 }
 
-void Game::handleMouseClick(int x, int y) {
+template <int Box>
+void BasicGame<Box>::handleMouseClick(int x, int y) {
     if (state == GameState::MENU) {
         handleMenuClick(x, y);
         return;
@@ -85,8 +104,8 @@ void Game::handleMouseClick(int x, int y) {
         int choice = renderer.handleDifficultyClick(x, y);
         if (choice >= 1 && choice <= 3) {
             difficulty = choice;
-            // Generate puzzle for chosen difficulty
-            sudoku.generatePuzzle(difficulty);
+            // Load a puzzle for chosen difficulty
+            loadNewPuzzle();
             selectedRow = selectedCol = -1;
             state = GameState::PLAYING;
             startTime = SDL_GetTicks();
@@ -108,18 +127,63 @@ void Game::handleMouseClick(int x, int y) {
     }
 }
 
-void Game::handleKeyPress(SDL_Keycode key) {
+template <int Box>
+void BasicGame<Box>::handleKeyPress(SDL_Keycode key) {
+    // Ctrl+Z undo, Ctrl+Y or Ctrl+Shift+Z redo, Ctrl+M back to the first mistake,
+    // Ctrl+N notes every candidate. Checked first: on big boards these letters are
+    // digits without Ctrl.
+    SDL_Keymod mods = SDL_GetModState();
+    if ((mods & KMOD_CTRL) && state == GameState::PLAYING) {
+        if (key == SDLK_z && !(mods & KMOD_SHIFT)) {
+            undoMove();
+        } else if (key == SDLK_y || key == SDLK_z) {
+            redoMove();
+        } else if (key == SDLK_m) {
+            rewindToFirstMistake();
+        } else if (key == SDLK_n) {
+            sudoku.fillNotes();     // not recorded; undo keeps working on top of the new notes
+        }
+        return;
+    }
+    // F3 prints the new-puzzle latency so far
+    if (key == SDLK_F3) {
+        reportLatency();
+        return;
+    }
+#ifdef SUDOKU_STATS
+    // F4 shows the solver work behind the current puzzle
+    if (key == SDLK_F4) {
+        renderer.toggleStatsOverlay();
+        return;
+    }
+#endif
+    // Space switches digit keys between placing and pencil marks
+    if (key == SDLK_SPACE && state == GameState::PLAYING) {
+        pencilMode = !pencilMode;
+        renderer.setPencilMode(pencilMode);
+        return;
+    }
+
+    // H asks for the next deduction; it needs no selection (9x9 only, where H is not a digit)
+    if constexpr (Box == 3) {
+        if (key == SDLK_h && state == GameState::PLAYING) {
+            renderer.setHint(hints.nextHint(sudoku));
+            return;
+        }
+    }
     if (selectedRow == -1 || selectedCol == -1) return;
 
-    if (key >= SDLK_1 && key <= SDLK_9) {
-        int num = key - SDLK_0;
-        if (sudoku.setNumber(selectedRow, selectedCol, num)) {
+    int num = keyDigit(key);
+    if (num > 0 && pencilMode) {
+        enterNote(selectedRow, selectedCol, num);
+    } else if (num > 0) {
+        if (enterNumber(selectedRow, selectedCol, num)) {
             checkWinCondition();
         }
     } else if (key == SDLK_BACKSPACE || key == SDLK_DELETE || key == SDLK_0) {
-        sudoku.setNumber(selectedRow, selectedCol, 0);
+        enterNumber(selectedRow, selectedCol, 0);
     } else if (key == SDLK_r) {
-        sudoku.generatePuzzle(difficulty);
+        loadNewPuzzle();
         startTime = SDL_GetTicks();
         elapsedSeconds = 0;
         currentElapsedSeconds = 0;
@@ -127,14 +191,110 @@ void Game::handleKeyPress(SDL_Keycode key) {
     }
 }
 
-void Game::checkWinCondition() {
+template <int Box>
+bool BasicGame<Box>::enterNumber(int row, int col, int num) {
+    int before = sudoku.getNumber(row, col);
+    if (before == num || !sudoku.setNumber(row, col, num)) {
+        return false;
+    }
+    Move move = {static_cast<uint16_t>(row * GRID_SIZE + col), static_cast<uint8_t>(before), static_cast<uint8_t>(num), 0, 0};
+    if (num != 0) {
+        // A placed digit hides the cell's notes and settles that digit for its peers
+        move.notesFlip = sudoku.getNotes(row, col);
+        sudoku.setNotes(row, col, 0);
+        move.peersCleared = sudoku.clearPeerNotes(row, col, num);
+    }
+    history.record(move);
+    renderer.clearHint();
+    return true;
+}
+
+template <int Box>
+bool BasicGame<Box>::enterNote(int row, int col, int num) {
+    if (!sudoku.toggleNote(row, col, num)) {
+        return false;
+    }
+    int digit = sudoku.getNumber(row, col);
+    history.record({static_cast<uint16_t>(row * GRID_SIZE + col), static_cast<uint8_t>(digit), static_cast<uint8_t>(digit),
+                    static_cast<uint32_t>(1u << (num - 1)), 0});
+    return true;
+}
+
+// Replays a recorded move either way and selects its cell, so the player sees what changed
+template <int Box>
+void BasicGame<Box>::applyMove(const Move& move, bool forward) {
+    static_assert(sizeof(typename BasicSudoku<Box>::Mask) <= sizeof(move.notesFlip), "notes must fit a move");
+    selectedRow = move.cell / GRID_SIZE;
+    selectedCol = move.cell % GRID_SIZE;
+    auto notes = sudoku.getNotes(selectedRow, selectedCol);
+    if (forward) {
+        sudoku.setNumber(selectedRow, selectedCol, move.after);
+        sudoku.setNotes(selectedRow, selectedCol, static_cast<decltype(notes)>(notes ^ move.notesFlip));
+        if (move.peersCleared != 0) sudoku.clearPeerNotes(selectedRow, selectedCol, move.after);
+    } else {
+        sudoku.setNumber(selectedRow, selectedCol, move.before);
+        sudoku.setNotes(selectedRow, selectedCol, static_cast<decltype(notes)>(notes ^ move.notesFlip));
+        if (move.peersCleared != 0) sudoku.restorePeerNotes(selectedRow, selectedCol, move.after, move.peersCleared);
+    }
+    renderer.clearHint();
+}
+
+template <int Box>
+void BasicGame<Box>::undoMove() {
+    if (history.canUndo()) {
+        applyMove(history.undo(), false);
+    }
+}
+
+template <int Box>
+void BasicGame<Box>::redoMove() {
+    if (history.canRedo()) {
+        applyMove(history.redo(), true);
+        checkWinCondition();
+    }
+}
+
+template <int Box>
+void BasicGame<Box>::rewindToFirstMistake() {
+    if (!hasSolution) return;
+    auto isWrong = [this](int cell, int num) { return num != 0 && num != solution[cell]; };
+
+    // The earliest move whose wrong digit is still on the board; everything from
+    // it on is undone (and stays redoable)
+    size_t count = history.undoableCount();
+    for (size_t i = 0; i < count; i++) {
+        const Move& move = history.undoable(i);
+        int cell = move.cell;
+        int current = sudoku.getNumber(cell / GRID_SIZE, cell % GRID_SIZE);
+        if (current == move.after && isWrong(cell, move.after)) {
+            while (history.undoableCount() > i) {
+                undoMove();
+            }
+            return;
+        }
+    }
+
+    // Made before the oldest move the history still holds: just point at it
+    for (int cell = 0; cell < GRID_SIZE * GRID_SIZE; cell++) {
+        int row = cell / GRID_SIZE;
+        int col = cell % GRID_SIZE;
+        if (sudoku.isCellEditable(row, col) && isWrong(cell, sudoku.getNumber(row, col))) {
+            selectedRow = row;
+            selectedCol = col;
+            return;
+        }
+    }
+}
+
+template <int Box>
+void BasicGame<Box>::checkWinCondition() {
     if (sudoku.isSolved()) {
         // Trigger completion effect
         if (selectedRow >= 0 && selectedCol >= 0) {
             renderer.completeEffect(sudoku, selectedRow, selectedCol, 1500);
         } else {
             // fallback center ripple
-            renderer.completeEffect(sudoku, 4, 4, 1000);
+            renderer.completeEffect(sudoku, GRID_SIZE / 2, GRID_SIZE / 2, 1000);
         }
 
         int action = 0;
@@ -163,7 +323,7 @@ void Game::checkWinCondition() {
             }
         }
         if (action == 1) {  // New Game 
-            sudoku.generatePuzzle(difficulty);
+            loadNewPuzzle();
             state = GameState::PLAYING;
             selectedRow = selectedCol = -1;
             startTime = SDL_GetTicks();
@@ -171,7 +331,7 @@ void Game::checkWinCondition() {
             currentElapsedSeconds = 0;
         } else if (action == 2) {  // Main Menu
             state = GameState::MENU;
-            sudoku = Sudoku();
+            sudoku = BasicSudoku<Box>(EmptyBoard());
             selectedRow = selectedCol = -1;
             startTime = SDL_GetTicks();
             elapsedSeconds = 0;
@@ -183,10 +343,85 @@ void Game::checkWinCondition() {
     }
 }
 
-void Game::updateTimer() {
+template <int Box>
+void BasicGame<Box>::loadNewPuzzle() {
+    // Every way into a new game (difficulty pick, R, "New Game") lands here, and the
+    // UI is frozen for all of it, so the whole call is what gets timed
+    auto start = std::chrono::steady_clock::now();
+
+    // The bank and the grader only know 9x9 boards
+    if constexpr (Box == 3) {
+        size_t banked = puzzleBank.getCount(difficulty);
+        if (banked > 0) {
+            size_t index = static_cast<size_t>(bankRng.below(banked));
+            sudoku.loadPacked(*puzzleBank.get(difficulty, index));
+        } else if (!puzzlePool.acquire(difficulty, sudoku)) {
+            // Prefer a prefetched puzzle; only generate on this thread when the pool ran dry
+            sudoku.generatePuzzle(difficulty);
+        }
+
+        // Label by the techniques the puzzle actually needs, not by its clue count
+        static const char* const LEVEL_NAMES[] = {"Easy", "Medium", "Hard"};
+        Grade grade = grader.grade(sudoku.getDigits());
+        renderer.setRating(std::string(LEVEL_NAMES[grade.getLevel() - 1]) + " - " + getTechniqueName(grade.hardest));
+        hints.reset(sudoku);    // solve once now so hints stay instant
+        solution = hints.getSolution();
+        hasSolution = hints.hasUniqueSolution();
+    } else {
+        if (!puzzlePool.acquire(difficulty, sudoku)) {
+            sudoku.generatePuzzle(difficulty);
+        }
+        solution = sudoku.getDigits();
+        hasSolution = getSolver<Box>(sudoku.getSolverEngine()).solve(solution) == 1;
+    }
+    renderer.clearHint();
+    history.clear();
+
+    auto micros = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    newPuzzleMicros[std::min(std::max(difficulty, 1), int(BasicPuzzlePool<Box>::LEVELS)) - 1].record(static_cast<uint64_t>(micros));
+    // Shown in the title bar so a reported puzzle can be rebuilt (sudoku-gen --id)
+    renderer.setPuzzleId(sudoku.getPuzzleId());
+}
+
+template <int Box>
+void BasicGame<Box>::reportLatency() const {
+    static const char* const LEVEL_NAMES[] = {"easy", "medium", "hard"};
+    std::printf("new puzzle latency (%dx%d): pool hits %llu, misses %llu\n", GRID_SIZE, GRID_SIZE,
+                static_cast<unsigned long long>(puzzlePool.getHits()), static_cast<unsigned long long>(puzzlePool.getMisses()));
+    for (int level = 0; level < BasicPuzzlePool<Box>::LEVELS; level++) {
+        const LatencyHistogram& histogram = newPuzzleMicros[level];
+        if (histogram.count() == 0) continue;
+        std::printf("  %-6s %6llu puzzles  p50 %8.2f ms  p99 %8.2f ms  max %8.2f ms\n", LEVEL_NAMES[level],
+                    static_cast<unsigned long long>(histogram.count()), histogram.percentile(0.50) / 1000.0,
+                    histogram.percentile(0.99) / 1000.0, histogram.max() / 1000.0);
+    }
+    std::fflush(stdout);
+}
+
+template <int Box>
+int BasicGame<Box>::keyDigit(SDL_Keycode key) {
+    if (key >= SDLK_1 && key <= SDLK_9) {
+        return key - SDLK_0;
+    }
+    if (key >= SDLK_KP_1 && key <= SDLK_KP_9) {
+        return key - SDLK_KP_1 + 1;
+    }
+    // Past 9 the digits are letters: A-G on 16x16, A-P on 25x25
+    if (key >= SDLK_a && key <= SDLK_z && key - SDLK_a + 10 <= GRID_SIZE) {
+        return key - SDLK_a + 10;
+    }
+    return 0;
+}
+
+template <int Box>
+void BasicGame<Box>::updateTimer() {
     if (running) {
         Uint32 currentTime = SDL_GetTicks();
         elapsedSeconds = (currentTime - startTime) / 1000;
         currentElapsedSeconds = elapsedSeconds;
     }
-}
\ No newline at end of file
+}
+
+template class BasicGame<3>;
+template class BasicGame<4>;
+template class BasicGame<5>;
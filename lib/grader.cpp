@@ -0,0 +1,490 @@
+#include "grader.h"
+#include <algorithm>
+
+namespace {
+
+const int N = SudokuTables::GRID_SIZE;
+const int CELLS = SudokuTables::CELL_COUNT;
+const uint16_t ALL_DIGITS = 0x1FF;
+
+// Score added per application, indexed by Technique
+const int TECHNIQUE_WEIGHT[] = {0, 1, 2, 5, 5, 10, 12, 15, 18, 25, 30, 35, 100};
+
+const char* const TECHNIQUE_NAME[] = {
+    "None", "Hidden Single", "Naked Single", "Pointing", "Claiming", "Naked Pair", "Hidden Pair",
+    "Naked Triple", "Hidden Triple", "X-Wing", "XY-Wing", "Swordfish", "Guess"
+};
+
+uint16_t digitBit(int num) { return static_cast<uint16_t>(1u << (num - 1)); }
+int bitDigit(uint16_t bit) { return __builtin_ctz(bit) + 1; }
+int countBits(unsigned mask) { return __builtin_popcount(mask); }
+
+bool sees(int a, int b) {
+    return SUDOKU_TABLES.rowOf[a] == SUDOKU_TABLES.rowOf[b] ||
+           SUDOKU_TABLES.colOf[a] == SUDOKU_TABLES.colOf[b] ||
+           SUDOKU_TABLES.boxOf[a] == SUDOKU_TABLES.boxOf[b];
+}
+
+// Position of a cell inside its row, column and box units
+int boxPosition(int cell) {
+    return (SUDOKU_TABLES.rowOf[cell] % SudokuTables::SUBGRID_SIZE) * SudokuTables::SUBGRID_SIZE +
+           SUDOKU_TABLES.colOf[cell] % SudokuTables::SUBGRID_SIZE;
+}
+
+// Next larger mask with the same number of set bits (Gosper's hack)
+unsigned nextCombination(unsigned mask) {
+    unsigned lowest = mask & -mask;
+    unsigned ripple = mask + lowest;
+    return (((ripple ^ mask) >> 2) / lowest) | ripple;
+}
+
+} // namespace
+
+const char* getTechniqueName(Technique technique) {
+    return TECHNIQUE_NAME[static_cast<int>(technique)];
+}
+
+int Grade::getLevel() const {
+    if (hardest <= Technique::NakedSingle) return 1;
+    if (hardest <= Technique::HiddenTriple) return 2;
+    return 3;
+}
+
+Grader::Grader() : grid{}, candidates{}, unitPlaces{}, placedDigits{}, filled(0), broken(false) {}
+
+void Grader::load(const SudokuGrid& puzzle) {
+    grid = puzzle;
+    filled = 0;
+    broken = false;
+    placedDigits.fill(0);
+    for (auto& places : unitPlaces) places.fill(0);
+
+    for (int cell = 0; cell < CELLS; cell++) {
+        if (grid[cell] == 0) continue;
+        uint16_t bit = digitBit(grid[cell]);
+        int units[3] = {SUDOKU_TABLES.rowOf[cell], N + SUDOKU_TABLES.colOf[cell], 2 * N + SUDOKU_TABLES.boxOf[cell]};
+        for (int unit : units) {
+            broken |= (placedDigits[unit] & bit) != 0;   // clashing givens
+            placedDigits[unit] |= bit;
+        }
+        filled++;
+    }
+
+    for (int cell = 0; cell < CELLS; cell++) {
+        candidates[cell] = 0;
+        if (grid[cell] != 0) continue;
+
+        int row = SUDOKU_TABLES.rowOf[cell];
+        int col = SUDOKU_TABLES.colOf[cell];
+        int box = SUDOKU_TABLES.boxOf[cell];
+        uint16_t digits = ALL_DIGITS & ~(placedDigits[row] | placedDigits[N + col] | placedDigits[2 * N + box]);
+        candidates[cell] = digits;
+        broken |= digits == 0;
+
+        while (digits) {
+            int d = __builtin_ctz(digits);
+            digits &= digits - 1;
+            unitPlaces[row][d] |= static_cast<uint16_t>(1u << col);
+            unitPlaces[N + col][d] |= static_cast<uint16_t>(1u << row);
+            unitPlaces[2 * N + box][d] |= static_cast<uint16_t>(1u << boxPosition(cell));
+        }
+    }
+
+    // A digit with neither a home nor a place left in some unit
+    for (int unit = 0; unit < SudokuTables::UNIT_COUNT; unit++) {
+        for (int d = 0; d < N; d++) {
+            broken |= !(placedDigits[unit] & (1u << d)) && unitPlaces[unit][d] == 0;
+        }
+    }
+}
+
+bool Grader::findStep(LogicStep& step) const {
+    step = LogicStep();
+    if (isSolved() || isBroken()) {
+        return false;
+    }
+    return findHiddenSingle(step) ||
+           findNakedSingle(step) ||
+           findPointing(step) ||
+           findClaiming(step) ||
+           findNakedSubset(step, 2) ||
+           findHiddenSubset(step, 2) ||
+           findNakedSubset(step, 3) ||
+           findHiddenSubset(step, 3) ||
+           findFish(step, 2) ||
+           findXYWing(step) ||
+           findFish(step, 3);
+}
+
+void Grader::apply(const LogicStep& step) {
+    if (step.isPlacement()) {
+        placeDigit(step.cell, step.digit);
+        return;
+    }
+    for (int cell = 0; cell < CELLS; cell++) {
+        if (step.affected[cell]) removeCandidates(cell, step.removeDigits);
+    }
+}
+
+void Grader::placeDigit(int cell, int digit) {
+    uint16_t bit = digitBit(digit);
+    grid[cell] = static_cast<uint8_t>(digit);
+    filled++;
+    placedDigits[SUDOKU_TABLES.rowOf[cell]] |= bit;
+    placedDigits[N + SUDOKU_TABLES.colOf[cell]] |= bit;
+    placedDigits[2 * N + SUDOKU_TABLES.boxOf[cell]] |= bit;
+
+    removeCandidates(cell, candidates[cell]);
+    for (uint8_t peer : SUDOKU_TABLES.peers[cell]) {
+        removeCandidates(peer, bit);
+    }
+}
+
+// Also notices contradictions as they appear, so isBroken never has to rescan
+void Grader::removeCandidates(int cell, uint16_t digits) {
+    digits &= candidates[cell];
+    if (digits == 0) {
+        return;
+    }
+    candidates[cell] &= ~digits;
+    broken |= grid[cell] == 0 && candidates[cell] == 0;
+
+    int row = SUDOKU_TABLES.rowOf[cell];
+    int col = SUDOKU_TABLES.colOf[cell];
+    int box = SUDOKU_TABLES.boxOf[cell];
+    uint16_t rowBit = static_cast<uint16_t>(1u << col);
+    uint16_t colBit = static_cast<uint16_t>(1u << row);
+    uint16_t boxBit = static_cast<uint16_t>(1u << boxPosition(cell));
+    while (digits) {
+        int d = __builtin_ctz(digits);
+        digits &= digits - 1;
+        int units[3] = {row, N + col, 2 * N + box};
+        uint16_t bits[3] = {rowBit, colBit, boxBit};
+        for (int u = 0; u < 3; u++) {
+            uint16_t& places = unitPlaces[units[u]][d];
+            places &= ~bits[u];
+            broken |= places == 0 && !(placedDigits[units[u]] & (1u << d));
+        }
+    }
+}
+
+Grade Grader::grade(const SudokuGrid& puzzle) {
+    load(puzzle);
+
+    Grade result;
+    LogicStep step;
+    while (findStep(step)) {
+        apply(step);
+        result.steps++;
+        result.score += TECHNIQUE_WEIGHT[static_cast<int>(step.technique)];
+        result.hardest = std::max(result.hardest, step.technique);
+    }
+
+    result.solved = isSolved();
+    if (!result.solved) {
+        result.score += TECHNIQUE_WEIGHT[static_cast<int>(Technique::Guess)];
+        result.hardest = Technique::Guess;
+    }
+    return result;
+}
+
+bool Grader::collectEliminations(LogicStep& step, const uint8_t* cells, int count, uint16_t digits,
+                                 const std::bitset<SudokuTables::CELL_COUNT>& exclude) const {
+    bool any = false;
+    for (int i = 0; i < count; i++) {
+        int cell = cells[i];
+        if (!exclude[cell] && (candidates[cell] & digits)) {
+            step.affected.set(cell);
+            any = true;
+        }
+    }
+    step.removeDigits = digits;
+    return any;
+}
+
+bool Grader::findHiddenSingle(LogicStep& step) const {
+    // Boxes first (18..26), the way people scan, then rows and columns
+    for (int i = 0; i < SudokuTables::UNIT_COUNT; i++) {
+        int unit = (i + 2 * N) % SudokuTables::UNIT_COUNT;
+        uint16_t once = 0, twice = 0;
+        for (uint8_t cell : SUDOKU_TABLES.units[unit]) {
+            twice |= once & candidates[cell];
+            once |= candidates[cell];
+        }
+
+        uint16_t hidden = once & ~twice;
+        if (hidden == 0) continue;
+
+        uint16_t bit = hidden & -hidden;
+        for (uint8_t cell : SUDOKU_TABLES.units[unit]) {
+            if (candidates[cell] & bit) {
+                step.technique = Technique::HiddenSingle;
+                step.cell = cell;
+                step.digit = bitDigit(bit);
+                step.unit = unit;
+                step.addPattern(cell);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool Grader::findNakedSingle(LogicStep& step) const {
+    for (int cell = 0; cell < CELLS; cell++) {
+        uint16_t c = candidates[cell];
+        if (c != 0 && (c & (c - 1)) == 0) {
+            step.technique = Technique::NakedSingle;
+            step.cell = cell;
+            step.digit = bitDigit(c);
+            step.addPattern(cell);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool Grader::findPointing(LogicStep& step) const {
+    for (int box = 0; box < N; box++) {
+        int unit = 2 * N + box;
+        const uint8_t* boxCells = SUDOKU_TABLES.units[unit];
+
+        for (int digit = 1; digit <= N; digit++) {
+            uint16_t positions = unitPositions(unit, digit);
+            if (countBits(positions) < 2) continue;
+
+            // Do all of this box's candidates for the digit share a row, or a column?
+            int first = boxCells[__builtin_ctz(positions)];
+            bool sameRow = true, sameCol = true;
+            for (int i = 0; i < N; i++) {
+                if (!(positions & (1u << i))) continue;
+                sameRow &= SUDOKU_TABLES.rowOf[boxCells[i]] == SUDOKU_TABLES.rowOf[first];
+                sameCol &= SUDOKU_TABLES.colOf[boxCells[i]] == SUDOKU_TABLES.colOf[first];
+            }
+            if (!sameRow && !sameCol) continue;
+
+            std::bitset<CELLS> inBox;
+            for (int i = 0; i < N; i++) inBox.set(boxCells[i]);
+            int line = sameRow ? SUDOKU_TABLES.rowOf[first] : N + SUDOKU_TABLES.colOf[first];
+            if (collectEliminations(step, SUDOKU_TABLES.units[line], N, digitBit(digit), inBox)) {
+                step.technique = Technique::Pointing;
+                step.digit = digit;
+                step.unit = unit;
+                for (int i = 0; i < N; i++) {
+                    if (positions & (1u << i)) step.addPattern(boxCells[i]);
+                }
+                return true;
+            }
+            step.affected.reset();
+        }
+    }
+    return false;
+}
+
+bool Grader::findClaiming(LogicStep& step) const {
+    for (int line = 0; line < 2 * N; line++) {
+        const uint8_t* lineCells = SUDOKU_TABLES.units[line];
+
+        for (int digit = 1; digit <= N; digit++) {
+            uint16_t positions = unitPositions(line, digit);
+            if (countBits(positions) < 2) continue;
+
+            int box = SUDOKU_TABLES.boxOf[lineCells[__builtin_ctz(positions)]];
+            bool sameBox = true;
+            for (int i = 0; i < N; i++) {
+                if (positions & (1u << i)) sameBox &= SUDOKU_TABLES.boxOf[lineCells[i]] == box;
+            }
+            if (!sameBox) continue;
+
+            std::bitset<CELLS> inLine;
+            for (int i = 0; i < N; i++) inLine.set(lineCells[i]);
+            if (collectEliminations(step, SUDOKU_TABLES.units[2 * N + box], N, digitBit(digit), inLine)) {
+                step.technique = Technique::Claiming;
+                step.digit = digit;
+                step.unit = line;
+                for (int i = 0; i < N; i++) {
+                    if (positions & (1u << i)) step.addPattern(lineCells[i]);
+                }
+                return true;
+            }
+            step.affected.reset();
+        }
+    }
+    return false;
+}
+
+bool Grader::findNakedSubset(LogicStep& step, int size) const {
+    for (int unit = 0; unit < SudokuTables::UNIT_COUNT; unit++) {
+        const uint8_t* unitCells = SUDOKU_TABLES.units[unit];
+
+        // Unit positions of the cells small enough to be part of the subset
+        uint8_t eligible[N];
+        int count = 0;
+        for (int i = 0; i < N; i++) {
+            int size_i = countBits(candidates[unitCells[i]]);
+            if (size_i >= 2 && size_i <= size) eligible[count++] = static_cast<uint8_t>(i);
+        }
+        if (count < size) continue;
+
+        for (unsigned combo = (1u << size) - 1; combo < (1u << count); combo = nextCombination(combo)) {
+            uint16_t digits = 0;
+            std::bitset<CELLS> members;
+            for (int i = 0; i < count; i++) {
+                if (!(combo & (1u << i))) continue;
+                digits |= candidates[unitCells[eligible[i]]];
+                members.set(unitCells[eligible[i]]);
+            }
+            if (countBits(digits) != size) continue;
+
+            if (collectEliminations(step, unitCells, N, digits, members)) {
+                step.technique = size == 2 ? Technique::NakedPair : Technique::NakedTriple;
+                step.unit = unit;
+                for (int i = 0; i < count; i++) {
+                    if (combo & (1u << i)) step.addPattern(unitCells[eligible[i]]);
+                }
+                return true;
+            }
+            step.affected.reset();
+        }
+    }
+    return false;
+}
+
+bool Grader::findHiddenSubset(LogicStep& step, int size) const {
+    for (int unit = 0; unit < SudokuTables::UNIT_COUNT; unit++) {
+        const uint8_t* unitCells = SUDOKU_TABLES.units[unit];
+
+        // Digits that fit in few enough places to be part of the subset
+        uint16_t positions[N + 1];
+        uint8_t eligible[N];
+        int count = 0;
+        for (int digit = 1; digit <= N; digit++) {
+            positions[digit] = unitPositions(unit, digit);
+            int places = countBits(positions[digit]);
+            if (places >= 2 && places <= size) eligible[count++] = static_cast<uint8_t>(digit);
+        }
+        if (count < size) continue;
+
+        for (unsigned combo = (1u << size) - 1; combo < (1u << count); combo = nextCombination(combo)) {
+            uint16_t places = 0;
+            uint16_t digits = 0;
+            for (int i = 0; i < count; i++) {
+                if (!(combo & (1u << i))) continue;
+                places |= positions[eligible[i]];
+                digits |= digitBit(eligible[i]);
+            }
+            if (countBits(places) != size) continue;
+
+            // Those cells can hold nothing but the subset's digits
+            uint16_t others = ALL_DIGITS & ~digits;
+            bool any = false;
+            for (int i = 0; i < N; i++) {
+                if ((places & (1u << i)) && (candidates[unitCells[i]] & others)) {
+                    step.affected.set(unitCells[i]);
+                    any = true;
+                }
+            }
+            if (!any) continue;
+
+            step.technique = size == 2 ? Technique::HiddenPair : Technique::HiddenTriple;
+            step.removeDigits = others;
+            step.unit = unit;
+            for (int i = 0; i < N; i++) {
+                if (places & (1u << i)) step.addPattern(unitCells[i]);
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+bool Grader::findFish(LogicStep& step, int size) const {
+    for (int digit = 1; digit <= N; digit++) {
+        uint16_t bit = digitBit(digit);
+
+        // Base lines are rows (cover columns), then columns (cover rows)
+        for (int orientation = 0; orientation < 2; orientation++) {
+            int baseOffset = orientation * N;
+            int coverOffset = (1 - orientation) * N;
+
+            uint16_t positions[N];
+            uint8_t eligible[N];
+            int count = 0;
+            for (int line = 0; line < N; line++) {
+                positions[line] = unitPositions(baseOffset + line, digit);
+                int places = countBits(positions[line]);
+                if (places >= 2 && places <= size) eligible[count++] = static_cast<uint8_t>(line);
+            }
+            if (count < size) continue;
+
+            for (unsigned combo = (1u << size) - 1; combo < (1u << count); combo = nextCombination(combo)) {
+                uint16_t covers = 0;
+                std::bitset<CELLS> baseCells;
+                for (int i = 0; i < count; i++) {
+                    if (!(combo & (1u << i))) continue;
+                    covers |= positions[eligible[i]];
+                    for (uint8_t cell : SUDOKU_TABLES.units[baseOffset + eligible[i]]) baseCells.set(cell);
+                }
+                if (countBits(covers) != size) continue;
+
+                bool any = false;
+                for (int cover = 0; cover < N; cover++) {
+                    if (!(covers & (1u << cover))) continue;
+                    LogicStep partial;
+                    if (collectEliminations(partial, SUDOKU_TABLES.units[coverOffset + cover], N, bit, baseCells)) {
+                        step.affected |= partial.affected;
+                        any = true;
+                    }
+                }
+                if (!any) continue;
+
+                step.technique = size == 2 ? Technique::XWing : Technique::Swordfish;
+                step.digit = digit;
+                step.removeDigits = bit;
+                for (int cell = 0; cell < CELLS; cell++) {
+                    if (baseCells[cell] && (candidates[cell] & bit)) step.addPattern(cell);
+                }
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool Grader::findXYWing(LogicStep& step) const {
+    for (int pivot = 0; pivot < CELLS; pivot++) {
+        uint16_t pivotDigits = candidates[pivot];
+        if (countBits(pivotDigits) != 2) continue;
+
+        for (uint8_t first : SUDOKU_TABLES.peers[pivot]) {
+            uint16_t firstDigits = candidates[first];
+            if (countBits(firstDigits) != 2 || countBits(firstDigits & pivotDigits) != 1) continue;
+
+            // Pivot {x,y}, first pincer {x,z}: the second pincer must be {y,z}
+            uint16_t z = firstDigits & ~pivotDigits;
+            uint16_t secondDigits = (pivotDigits & ~firstDigits) | z;
+            for (uint8_t second : SUDOKU_TABLES.peers[pivot]) {
+                if (second == first || candidates[second] != secondDigits) continue;
+
+                bool any = false;
+                for (int cell = 0; cell < CELLS; cell++) {
+                    if (cell == first || cell == second || !(candidates[cell] & z)) continue;
+                    if (sees(cell, first) && sees(cell, second)) {
+                        step.affected.set(cell);
+                        any = true;
+                    }
+                }
+                if (!any) continue;
+
+                step.technique = Technique::XYWing;
+                step.digit = bitDigit(z);
+                step.removeDigits = z;
+                step.addPattern(pivot);
+                step.addPattern(first);
+                step.addPattern(second);
+                return true;
+            }
+        }
+    }
+    return false;
+}
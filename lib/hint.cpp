@@ -0,0 +1,134 @@
+#include "hint.h"
+#include <string>
+
+namespace {
+
+const int CELLS = SudokuTables::CELL_COUNT;
+
+std::string cellName(int cell) {
+    return "r" + std::to_string(SUDOKU_TABLES.rowOf[cell] + 1) + "c" + std::to_string(SUDOKU_TABLES.colOf[cell] + 1);
+}
+
+SudokuGrid givensOf(const Sudoku& sudoku) {
+    SudokuGrid grid = sudoku.getDigits();
+    for (int cell = 0; cell < CELLS; cell++) {
+        if (sudoku.isCellEditable(SUDOKU_TABLES.rowOf[cell], SUDOKU_TABLES.colOf[cell])) grid[cell] = 0;
+    }
+    return grid;
+}
+
+} // namespace
+
+std::string Hint::describe() const {
+    switch (kind) {
+        case HintKind::Step: {
+            std::string text = step.technique == Technique::Guess ? "No logical step" : getTechniqueName(step.technique);
+            if (step.isPlacement()) {
+                return text + ": " + cellName(step.cell) + " = " + std::to_string(step.digit);
+            }
+            text += ": remove";
+            for (int d = 1; d <= SudokuTables::GRID_SIZE; d++) {
+                if (step.removeDigits & (1u << (d - 1))) text += " " + std::to_string(d);
+            }
+            text += " from";
+            const int MAX_LISTED = 3;
+            int listed = 0;
+            for (int cell = 0; cell < CELLS; cell++) {
+                if (!step.affected[cell]) continue;
+                if (listed++ == MAX_LISTED) {
+                    text += " ...";
+                    break;
+                }
+                text += " " + cellName(cell);
+            }
+            return text;
+        }
+        case HintKind::Mistakes: {
+            size_t count = mistakes.count();
+            return std::to_string(count) + (count == 1 ? " wrong digit" : " wrong digits");
+        }
+        case HintKind::Solved:
+            return "Solved";
+        case HintKind::NoSolution:
+            return "No unique solution";
+        default:
+            return "";
+    }
+}
+
+HintEngine::HintEngine() : givens{}, solution{}, synced{}, hasSolution(false), loaded(false) {}
+
+void HintEngine::reset(const Sudoku& sudoku) {
+    givens = givensOf(sudoku);
+    solution = givens;
+    hasSolution = getSolver(sudoku.getSolverEngine()).solve(solution, 2) == 1;
+    grader.load(givens);
+    synced = givens;
+    loaded = true;
+}
+
+// Brings the grader up to the board: new correct digits are placed on top of the
+// cached candidates (keeping hinted eliminations); anything else reloads it
+void HintEngine::sync(const SudokuGrid& digits) {
+    for (int cell = 0; cell < CELLS; cell++) {
+        if (digits[cell] == synced[cell]) continue;
+        if (synced[cell] != 0) {
+            grader.load(digits);
+            synced = digits;
+            return;
+        }
+        LogicStep placement;
+        placement.cell = cell;
+        placement.digit = digits[cell];
+        grader.apply(placement);
+        synced[cell] = digits[cell];
+    }
+}
+
+Hint HintEngine::nextHint(const Sudoku& sudoku) {
+    if (!loaded || givensOf(sudoku) != givens) {
+        reset(sudoku);
+    }
+
+    Hint hint;
+    if (!hasSolution) {
+        hint.kind = HintKind::NoSolution;
+        return hint;
+    }
+
+    // Any user digit off the solution is reported before logic is asked to build on it
+    SudokuGrid digits = sudoku.getDigits();
+    for (int cell = 0; cell < CELLS; cell++) {
+        if (digits[cell] != 0 && digits[cell] != solution[cell]) hint.mistakes.set(cell);
+    }
+    if (hint.mistakes.any()) {
+        hint.kind = HintKind::Mistakes;
+        return hint;
+    }
+
+    sync(digits);
+    if (grader.isSolved()) {
+        hint.kind = HintKind::Solved;
+        return hint;
+    }
+
+    hint.kind = HintKind::Step;
+    if (grader.findStep(hint.step)) {
+        // The player cannot act on an elimination yet, so it is taken here and the next call moves on
+        if (!hint.step.isPlacement()) grader.apply(hint.step);
+        return hint;
+    }
+
+    // Stuck: give away the solution digit of the cell with the fewest candidates
+    int best = -1;
+    for (int cell = 0; cell < CELLS; cell++) {
+        if (digits[cell] != 0) continue;
+        if (best < 0 || __builtin_popcount(grader.getCandidates(cell)) < __builtin_popcount(grader.getCandidates(best))) {
+            best = cell;
+        }
+    }
+    hint.step.technique = Technique::Guess;
+    hint.step.cell = best;
+    hint.step.digit = solution[best];
+    return hint;
+}
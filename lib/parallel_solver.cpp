@@ -0,0 +1,191 @@
+#include "parallel_solver.h"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+template <int Box>
+BasicParallelSolver<Box>::BasicParallelSolver(int threads)
+    : firstSolution(nullptr), solutionLimit(1), solutionCount(0), stopping(false), pending(0), idle(0), steals(0) {
+    if (threads <= 0) {
+        threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+    for (int i = 0; i < threads; i++) {
+        workers.push_back(std::make_unique<Worker>());
+    }
+}
+
+template <int Box>
+int BasicParallelSolver<Box>::solve(Grid& grid, int limit) {
+    // Most boards are done long before threads would even start. A board that
+    // outgrows SEQUENTIAL_NODES is searched again from the root, so the pre-pass
+    // is pure overhead there: about a millisecond, small next to such a search
+    Grid attempt = grid;
+    sequential.setNodeLimit(SEQUENTIAL_NODES);
+    int found = sequential.solve(attempt, limit);
+    if (!sequential.hitNodeLimit()) {
+        if (found > 0) grid = attempt;
+        return found;
+    }
+
+    State root;
+    if (!Backtracker::load(root, grid)) {
+        return 0;
+    }
+    firstSolution = &grid;
+    solutionLimit = limit;
+    solutionCount = 0;
+    stopping = false;
+    idle = 0;
+    steals = 0;
+    for (auto& worker : workers) {
+        worker->tasks.clear();   // leftovers of a search that stopped early
+    }
+    pending = 1;
+    workers[0]->tasks.push_back(root);
+#ifdef SUDOKU_STATS
+    workerStats = SolverStats();
+#endif
+
+    // Threads live for one solve only; starting them is noise next to a search
+    // that already outgrew SEQUENTIAL_NODES
+    std::vector<std::thread> pool;
+    for (int i = 1; i < getThreads(); i++) {
+        pool.emplace_back(&BasicParallelSolver::run, this, i);
+    }
+    run(0);
+    for (auto& thread : pool) {
+        thread.join();
+    }
+#ifdef SUDOKU_STATS
+    threadSolverStats() += workerStats;
+#endif
+    return std::min(solutionCount.load(), limit);
+}
+
+template <int Box>
+void BasicParallelSolver<Box>::run(int self) {
+#ifdef SUDOKU_STATS
+    SolverStats before = threadSolverStats();
+#endif
+    State task;
+    bool waiting = false;
+    int misses = 0;
+    while (!stopping.load(std::memory_order_relaxed)) {
+        if (takeTask(self, task)) {
+            if (waiting) {
+                idle--;
+                waiting = false;
+                misses = 0;
+            }
+            search(self, task);
+            pending--;
+        } else if (pending.load() == 0) {
+            break;
+        } else {
+            if (!waiting) {
+                idle++;
+                waiting = true;
+            }
+            // Spin briefly, then back off so idle workers leave the cores to busy ones
+            if (++misses < IDLE_SPINS) {
+                std::this_thread::yield();
+            } else {
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+            }
+        }
+    }
+    if (waiting) idle--;
+#ifdef SUDOKU_STATS
+    // Worker 0 is the calling thread, whose counters the caller already reads
+    if (self != 0) {
+        std::lock_guard<std::mutex> lock(solutionMutex);
+        workerStats += threadSolverStats() - before;
+    }
+#endif
+}
+
+template <int Box>
+bool BasicParallelSolver<Box>::takeTask(int self, State& task) {
+    {
+        Worker& own = *workers[self];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = own.tasks.back();
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+    int count = getThreads();
+    for (int i = 1; i < count; i++) {
+        Worker& victim = *workers[(self + i) % count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = victim.tasks.front();
+            victim.tasks.pop_front();
+            steals++;
+            return true;
+        }
+    }
+    return false;
+}
+
+template <int Box>
+void BasicParallelSolver<Box>::search(int self, State& state) {
+    if (stopping.load(std::memory_order_relaxed)) {
+        return;
+    }
+    SUDOKU_STAT(nodes, 1);
+    if (!Backtracker::propagate(state)) {
+        return;
+    }
+
+    Choice choices[Tables::GRID_SIZE];
+    int count = Backtracker::findBranch(state, choices);
+    if (count < 0) {
+        int found = ++solutionCount;
+        if (found == 1) {
+            std::lock_guard<std::mutex> lock(solutionMutex);
+            *firstSolution = state.grid;
+        }
+        if (found >= solutionLimit) {
+            stopping = true;
+        }
+        return;
+    }
+
+    // While someone is idle, every branch but the first goes to the deque
+    int kept = count;
+    if (count > 1 && idle.load(std::memory_order_relaxed) > 0) {
+        Worker& own = *workers[self];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        for (int i = count - 1; i >= 1; i--) {
+            State next = state;
+            if (Backtracker::assign(next, choices[i].cell, choices[i].num)) {
+                pending++;
+                own.tasks.push_back(next);
+            }
+        }
+        kept = 1;
+    }
+
+    for (int i = 0; i < kept && !stopping.load(std::memory_order_relaxed); i++) {
+        State next = state;
+        if (Backtracker::assign(next, choices[i].cell, choices[i].num)) {
+            search(self, next);
+        }
+    }
+}
+
+template <int Box>
+BasicSolver<Box>& getParallelSolver() {
+    thread_local BasicParallelSolver<Box> parallel;
+    return parallel;
+}
+
+template class BasicParallelSolver<3>;
+template class BasicParallelSolver<4>;
+template class BasicParallelSolver<5>;
+
+template BasicSolver<3>& getParallelSolver<3>();
+template BasicSolver<4>& getParallelSolver<4>();
+template BasicSolver<5>& getParallelSolver<5>();
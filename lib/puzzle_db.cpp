@@ -0,0 +1,136 @@
+#include "puzzle_db.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+const char DB_MAGIC[4] = {'S', 'D', 'K', 'B'};
+const uint32_t DB_VERSION = 1;
+
+int levelIndex(int difficulty) {
+    return std::min(std::max(difficulty, 1), int(PuzzleDbHeader::LEVELS)) - 1;
+}
+
+} // namespace
+
+PuzzleDb::PuzzleDb() : mapping(nullptr), mappingSize(0), header(nullptr), records(nullptr) {}
+
+PuzzleDb::~PuzzleDb() {
+    close();
+}
+
+bool PuzzleDb::open(const std::string& path) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(PuzzleDbHeader)) {
+        ::close(fd);
+        return false;
+    }
+
+    size_t size = static_cast<size_t>(info.st_size);
+    void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // the mapping stays valid without the descriptor
+    if (data == MAP_FAILED) {
+        return false;
+    }
+
+    const PuzzleDbHeader* candidate = static_cast<const PuzzleDbHeader*>(data);
+    bool valid = std::memcmp(candidate->magic, DB_MAGIC, sizeof(DB_MAGIC)) == 0 &&
+                 candidate->version == DB_VERSION &&
+                 candidate->recordSize == sizeof(PackedPuzzle);
+
+    // Every count and offset is checked against the records that fit in the file
+    // before it is added to anything, so a hostile header cannot wrap the sums
+    const uint64_t capacity = (size - sizeof(PuzzleDbHeader)) / sizeof(PackedPuzzle);
+    uint64_t total = 0;
+    for (int level = 0; level < PuzzleDbHeader::LEVELS && valid; level++) {
+        uint64_t count = candidate->levelCount[level];
+        valid = count <= capacity - total;
+        total += valid ? count : 0;
+    }
+    for (int level = 0; level < PuzzleDbHeader::LEVELS && valid; level++) {
+        uint64_t offset = candidate->levelOffset[level];
+        valid = offset <= total && candidate->levelCount[level] <= total - offset;
+    }
+    if (!valid) {
+        munmap(data, size);
+        return false;
+    }
+
+    mapping = data;
+    mappingSize = size;
+    header = candidate;
+    records = reinterpret_cast<const PackedPuzzle*>(static_cast<const char*>(data) + sizeof(PuzzleDbHeader));
+    return true;
+}
+
+void PuzzleDb::close() {
+    if (mapping) {
+        munmap(mapping, mappingSize);
+    }
+    mapping = nullptr;
+    mappingSize = 0;
+    header = nullptr;
+    records = nullptr;
+}
+
+size_t PuzzleDb::getCount(int difficulty) const {
+    if (!header) return 0;
+    return static_cast<size_t>(header->levelCount[levelIndex(difficulty)]);
+}
+
+const PackedPuzzle* PuzzleDb::get(int difficulty, size_t index) const {
+    if (index >= getCount(difficulty)) {
+        return nullptr;
+    }
+    return &records[header->levelOffset[levelIndex(difficulty)] + index];
+}
+
+void PuzzleDbWriter::add(const PackedPuzzle& puzzle) {
+    levels[levelIndex(puzzle.difficulty)].push_back(puzzle);
+}
+
+size_t PuzzleDbWriter::size() const {
+    size_t total = 0;
+    for (const auto& level : levels) {
+        total += level.size();
+    }
+    return total;
+}
+
+bool PuzzleDbWriter::write(const std::string& path) const {
+    PuzzleDbHeader header = {};
+    std::memcpy(header.magic, DB_MAGIC, sizeof(DB_MAGIC));
+    header.version = DB_VERSION;
+    header.recordSize = sizeof(PackedPuzzle);
+
+    uint64_t offset = 0;
+    for (int level = 0; level < PuzzleDbHeader::LEVELS; level++) {
+        header.levelOffset[level] = offset;
+        header.levelCount[level] = levels[level].size();
+        offset += levels[level].size();
+    }
+
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+    for (const auto& level : levels) {
+        if (ok && !level.empty()) {
+            ok = std::fwrite(level.data(), sizeof(PackedPuzzle), level.size(), file) == level.size();
+        }
+    }
+    return std::fclose(file) == 0 && ok;
+}
@@ -0,0 +1,70 @@
+#include "puzzle_pool.h"
+#include <algorithm>
+#include <chrono>
+
+template <int Box>
+BasicPuzzlePool<Box>::BasicPuzzlePool() : running(false), hits(0), misses(0) {}
+
+template <int Box>
+BasicPuzzlePool<Box>::~BasicPuzzlePool() {
+    stop();
+}
+
+template <int Box>
+void BasicPuzzlePool<Box>::start() {
+    if (running.exchange(true)) {
+        return;
+    }
+    worker = std::thread(&BasicPuzzlePool::workerLoop, this);
+}
+
+template <int Box>
+void BasicPuzzlePool<Box>::stop() {
+    if (!running.exchange(false)) {
+        return;
+    }
+    wake.notify_one();
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+template <int Box>
+bool BasicPuzzlePool<Box>::acquire(int difficulty, BasicSudoku<Box>& out) {
+    int level = std::min(std::max(difficulty, 1), int(LEVELS)) - 1;
+    if (!queues[level].pop(out)) {
+        misses.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    hits.fetch_add(1, std::memory_order_relaxed);
+    wake.notify_one(); // a slot just freed up
+    return true;
+}
+
+template <int Box>
+void BasicPuzzlePool<Box>::workerLoop() {
+    BasicSudoku<Box> scratch{EmptyBoard()};
+
+    while (running.load()) {
+        // One puzzle per level per pass, so a level the player just drained
+        // never waits behind a full refill of the others
+        bool producedAny = false;
+        for (int level = 0; level < LEVELS && running.load(); level++) {
+            if (queues[level].full()) continue;
+
+            scratch.generatePuzzle(level + 1);
+            queues[level].push(scratch);
+            producedAny = true;
+        }
+
+        if (!producedAny) {
+            // Everything is full; sleep until a puzzle is taken (the timeout covers a missed notify)
+            std::unique_lock<std::mutex> lock(wakeMutex);
+            wake.wait_for(lock, std::chrono::milliseconds(100));
+        }
+    }
+}
+
+template class BasicPuzzlePool<3>;
+template class BasicPuzzlePool<4>;
+template class BasicPuzzlePool<5>;
@@ -1,6 +1,7 @@
 #include "renderer.h"
 #include "game.h"
 #include <stdexcept>
+#include <algorithm>
 #include <array>
 #include <sstream>
 #include <iostream>
@@ -11,10 +12,21 @@
 
 SDL_Texture *Renderer::iconTexture = nullptr;
 const int GRID_START_Y = 50;
-const int GRID_PIXELS = Sudoku::GRID_SIZE * Renderer::CELL_SIZE;
-const int GRID_START_X = (Renderer::WINDOW_WIDTH - GRID_PIXELS) / 2;
 
-Renderer::Renderer() : window(nullptr), renderer(nullptr), font(nullptr), icon(nullptr) {}
+Renderer::Renderer()
+    : window(nullptr), renderer(nullptr), font(nullptr), noteFont(nullptr), icon(nullptr), pencilMode(false),
+      labelTexture(nullptr), labelW(0), labelH(0), atlas(nullptr), atlasFont(nullptr), glyphRects{}, boardLayer{}, tallyLayer{} {
+    setLayout(Sudoku::SUBGRID_SIZE);
+}
+
+void Renderer::setLayout(int subgridSize) {
+    // The grid keeps the 9x9 footprint; bigger boards get smaller cells
+    boxSize = subgridSize;
+    gridSize = subgridSize * subgridSize;
+    cellSize = (CELL_SIZE * Sudoku::GRID_SIZE) / gridSize;
+    gridPixels = cellSize * gridSize;
+    gridStartX = (WINDOW_WIDTH - gridPixels) / 2;
+}
 
 Renderer::~Renderer() {
     if (iconTexture)
@@ -64,6 +76,11 @@ bool Renderer::init() {
         return false;
     }
 
+    noteFont = TTF_OpenFont("/System/Library/Fonts/Supplemental/Chalkboard.ttc", 12);
+    if (!noteFont) {
+        std::cerr << "Failed to load note font, scaling the main one: " << TTF_GetError() << std::endl;
+    }
+
     icon = IMG_Load("../image/menu_icon.png");
     if (icon) {
         // create texture once and free the surface
@@ -83,6 +100,11 @@ bool Renderer::init() {
 }
 
 void Renderer::close() {
+    releaseCaches();
+    if (noteFont) {
+        TTF_CloseFont(noteFont);
+        noteFont = nullptr;
+    }
     if (font) {
         TTF_CloseFont(font);
         font = nullptr;
@@ -99,7 +121,10 @@ void Renderer::close() {
     SDL_Quit();
 }
 
-void Renderer::render(const Sudoku& sudoku, int selectedRow, int selectedCol) {
+template <int Box>
+void Renderer::render(const BasicSudoku<Box>& sudoku, int selectedRow, int selectedCol) {
+    setLayout(Box);
+
     // Clear screen with white background
     SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
     SDL_RenderClear(renderer);
@@ -121,15 +146,25 @@ void Renderer::render(const Sudoku& sudoku, int selectedRow, int selectedCol) {
     SDL_Rect rightPadding = {WINDOW_WIDTH - 50, 0, 50, WINDOW_HEIGHT};
     SDL_RenderFillRect(renderer, &rightPadding);
 
-    renderTimer(Game::getElapsedSeconds());
+    renderTimer(BasicGame<Box>::getElapsedSeconds());
+    renderRating();
+    if (pencilMode) {
+        renderText("Notes", 170, 10, {110, 110, 110, 255});
+    }
 
     if (selectedRow >= 0 && selectedCol >= 0) {
         renderSelectedCell(selectedRow, selectedCol);
     }
+    renderHint();
 
     renderGrid();
     renderNumbers(sudoku);
     renderNumberCounts(sudoku);
+#ifdef SUDOKU_STATS
+    if (showStats) {
+        renderStats(sudoku.getStats());
+    }
+#endif
 
     // Present the final render
     SDL_RenderPresent(renderer);
@@ -139,90 +174,280 @@ void Renderer::renderGrid() {
     SDL_SetRenderDrawColor(renderer, 56, 87, 246, 255);
 
 	// Draw horizontal lines
-	for (int i = 0; i <= 9; i++) {
-		int lineWidth = (i % 3 == 0) ? 3 : 1;
-		int y = GRID_START_Y + i * CELL_SIZE;
-		SDL_Rect rect = {GRID_START_X, y - lineWidth/2, GRID_PIXELS, lineWidth};
+	for (int i = 0; i <= gridSize; i++) {
+		int lineWidth = (i % boxSize == 0) ? 3 : 1;
+		int y = GRID_START_Y + i * cellSize;
+		SDL_Rect rect = {gridStartX, y - lineWidth/2, gridPixels, lineWidth};
 		SDL_RenderFillRect(renderer, &rect);
 	}
 
 	// Draw vertical lines
-	for (int i = 0; i <= 9; i++) {
-		int lineWidth = (i % 3 == 0) ? 3 : 1;
-		int x = GRID_START_X + i * CELL_SIZE;
-		SDL_Rect rect = {x - lineWidth/2, GRID_START_Y, lineWidth, GRID_PIXELS};
+	for (int i = 0; i <= gridSize; i++) {
+		int lineWidth = (i % boxSize == 0) ? 3 : 1;
+		int x = gridStartX + i * cellSize;
+		SDL_Rect rect = {x - lineWidth/2, GRID_START_Y, lineWidth, gridPixels};
 		SDL_RenderFillRect(renderer, &rect);
 	}
 }
 
-void Renderer::renderNumbers(const Sudoku& sudoku) {
-    for (int row = 0; row < Sudoku::GRID_SIZE; row++) {
-        for (int col = 0; col < Sudoku::GRID_SIZE; col++) {
-            int number = sudoku.getNumber(row, col);
-            if (number != 0) {
-                bool isFixed = !sudoku.isCellEditable(row, col);
-                bool hasConflict = sudoku.hasConflict(row, col);
-                renderNumber(number, row, col, isFixed, hasConflict);
+template <int Box>
+void Renderer::renderNumbers(const BasicSudoku<Box>& sudoku) {
+    if (!buildAtlas()) return;
+
+    if (!prepareLayer(boardLayer, gridPixels, gridPixels)) {
+        // No render targets: every cell straight to the screen, every frame
+        for (int row = 0; row < gridSize; row++) {
+            for (int col = 0; col < gridSize; col++) {
+                renderCell(sudoku, row, col, gridStartX + col * cellSize, GRID_START_Y + row * cellSize);
             }
         }
+        return;
     }
-}
 
-void Renderer::renderNumber(int number, int row, int col, bool isFixed, bool hasConflict) {
-    SDL_Color color;
-    if (hasConflict) {
-        color = {255, 0, 0, 255}; // Red for conflicting numbers
-    } else {
-        color = isFixed ? SDL_Color{0, 0, 0, 255} : SDL_Color{0, 0, 255, 255}; // Black for fixed, Blue for user
+    uint64_t version = sudoku.getVersion();
+    bool full = layerIsStale(boardLayer, version);
+    if (full || version != boardLayer.version) {
+        SDL_SetRenderTarget(renderer, boardLayer.texture);
+        SDL_BlendMode blendMode;
+        SDL_GetRenderDrawBlendMode(renderer, &blendMode);
+        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);   // fills below clear to transparent
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+        if (full) {
+            SDL_RenderClear(renderer);
+        }
+        for (int row = 0; row < gridSize; row++) {
+            for (int col = 0; col < gridSize; col++) {
+                if (!full && !sudoku.isDirty(row, col)) continue;
+                SDL_Rect cellRect = {col * cellSize, row * cellSize, cellSize, cellSize};
+                if (!full) {
+                    SDL_RenderFillRect(renderer, &cellRect);
+                }
+                renderCell(sudoku, row, col, cellRect.x, cellRect.y);
+            }
+        }
+        SDL_SetRenderDrawBlendMode(renderer, blendMode);
+        SDL_SetRenderTarget(renderer, nullptr);
+        boardLayer.gridSize = gridSize;
+        boardLayer.version = version;
     }
+    drawLayer(boardLayer, gridStartX, GRID_START_Y);
+}
 
-    std::string text = std::to_string(number);
-    SDL_Surface* surface = TTF_RenderText_Blended(font, text.c_str(), color);
-    if (!surface) return;
-
-    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
-    SDL_FreeSurface(surface);
-    if (!texture) return;
-
-    int textW, textH;
-    SDL_QueryTexture(texture, nullptr, nullptr, &textW, &textH);
+// One cell's digit or pencil marks, with the cell's top-left corner at (x, y)
+template <int Box>
+void Renderer::renderCell(const BasicSudoku<Box>& sudoku, int row, int col, int x, int y) {
+    int number = sudoku.getNumber(row, col);
+    if (number != 0) {
+        GlyphStyle style = GlyphStyle::User;         // Blue for user
+        if (sudoku.hasConflict(row, col)) {
+            style = GlyphStyle::Conflict;            // Red for conflicting numbers
+        } else if (!sudoku.isCellEditable(row, col)) {
+            style = GlyphStyle::Fixed;               // Black for fixed
+        }
+        renderNumber(style, number, x, y);
+    } else if (auto notes = sudoku.getNotes(row, col)) {
+        renderNotes(notes, x, y);
+    }
+}
 
-    // Calculate the grid offset for proper positioning
-    const int GRID_START_Y = 50;
-    const int GRID_START_X = (WINDOW_WIDTH - (Sudoku::GRID_SIZE * CELL_SIZE)) / 2;
+void Renderer::renderNumber(GlyphStyle style, int number, int x, int y) {
+    const SDL_Rect& glyph = glyphRects[static_cast<int>(style)][number];
+    int textW = glyph.w, textH = glyph.h;
+    fitToCell(textW, textH);
 
     SDL_Rect dstRect = {
-        GRID_START_X + col * CELL_SIZE + (CELL_SIZE - textW) / 2,
-        GRID_START_Y + row * CELL_SIZE + (CELL_SIZE - textH) / 2,
+        x + (cellSize - textW) / 2,
+        y + (cellSize - textH) / 2,
         textW,
         textH
     };
 
-    SDL_RenderCopy(renderer, texture, nullptr, &dstRect);
-    SDL_DestroyTexture(texture);
+    drawGlyph(style, number, dstRect);
+}
+
+// Each noted digit sits in its own slot of a Box x Box mini grid inside the cell
+void Renderer::renderNotes(uint32_t notes, int x, int y) {
+    const int slot = cellSize / boxSize;
+
+    while (notes) {
+        int d = __builtin_ctz(notes);
+        notes &= notes - 1;
+
+        const SDL_Rect& glyph = glyphRects[static_cast<int>(GlyphStyle::Note)][d + 1];
+        int w = glyph.w, h = glyph.h;
+        if (h > slot) {
+            w = w * slot / h;
+            h = slot;
+        }
+        SDL_Rect dstRect = {
+            x + (d % boxSize) * slot + (slot - w) / 2,
+            y + (d / boxSize) * slot + (slot - h) / 2,
+            w,
+            h
+        };
+        drawGlyph(GlyphStyle::Note, d + 1, dstRect);
+    }
+}
+
+bool Renderer::buildAtlas() {
+    if (atlas && atlasFont == font) {
+        return true;
+    }
+    releaseCaches();
+    if (!font) {
+        return false;
+    }
+
+    struct Style {
+        SDL_Color color;
+        TTF_Font* font;
+        int fontStyle;
+    };
+    const Style styles[GLYPH_STYLES] = {
+        {{0, 0, 0, 255}, font, TTF_STYLE_NORMAL},
+        {{0, 0, 255, 255}, font, TTF_STYLE_NORMAL},
+        {{255, 0, 0, 255}, font, TTF_STYLE_NORMAL},
+        {{0, 0, 0, 255}, font, TTF_STYLE_BOLD},
+        {{56, 87, 246, 255}, font, TTF_STYLE_BOLD},
+        {{110, 110, 110, 255}, noteFont ? noteFont : font, TTF_STYLE_NORMAL},
+    };
+
+    // One row of glyphs per style, a pixel apart so scaled copies never bleed
+    SDL_Surface* glyphs[GLYPH_STYLES][ATLAS_SYMBOLS] = {};
+    int sheetW = 1, sheetH = 0;
+    for (int s = 0; s < GLYPH_STYLES; s++) {
+        TTF_SetFontStyle(styles[s].font, styles[s].fontStyle);
+        int x = 0, rowH = 0;
+        for (int i = 0; i < ATLAS_SYMBOLS; i++) {
+            const char text[2] = {i == 0 ? '0' : Sudoku::digitSymbol(i), '\0'};
+            glyphs[s][i] = TTF_RenderText_Blended(styles[s].font, text, styles[s].color);
+            glyphRects[s][i] = {0, 0, 0, 0};
+            if (!glyphs[s][i]) continue;
+            glyphRects[s][i] = {x, sheetH, glyphs[s][i]->w, glyphs[s][i]->h};
+            x += glyphs[s][i]->w + 1;
+            rowH = std::max(rowH, glyphs[s][i]->h);
+        }
+        TTF_SetFontStyle(styles[s].font, TTF_STYLE_NORMAL);
+        sheetW = std::max(sheetW, x);
+        sheetH += rowH + 1;
+    }
+
+    SDL_Surface* sheet = SDL_CreateRGBSurfaceWithFormat(0, sheetW, sheetH, 32, SDL_PIXELFORMAT_RGBA32);
+    for (int s = 0; s < GLYPH_STYLES; s++) {
+        for (int i = 0; i < ATLAS_SYMBOLS; i++) {
+            if (!glyphs[s][i]) continue;
+            if (sheet) {
+                // Copy the glyph's alpha as is instead of blending it onto the empty sheet
+                SDL_SetSurfaceBlendMode(glyphs[s][i], SDL_BLENDMODE_NONE);
+                SDL_Rect dstRect = glyphRects[s][i];
+                SDL_BlitSurface(glyphs[s][i], nullptr, sheet, &dstRect);
+            }
+            SDL_FreeSurface(glyphs[s][i]);
+        }
+    }
+    if (!sheet) {
+        std::cerr << "Failed to create glyph atlas: " << SDL_GetError() << std::endl;
+        return false;
+    }
+
+    atlas = SDL_CreateTextureFromSurface(renderer, sheet);
+    SDL_FreeSurface(sheet);
+    if (!atlas) {
+        std::cerr << "Failed to upload glyph atlas: " << SDL_GetError() << std::endl;
+        return false;
+    }
+    SDL_SetTextureBlendMode(atlas, SDL_BLENDMODE_BLEND);
+    atlasFont = font;
+    return true;
+}
+
+void Renderer::drawGlyph(GlyphStyle style, int symbol, const SDL_Rect& dstRect) {
+    const SDL_Rect& srcRect = glyphRects[static_cast<int>(style)][symbol];
+    if (srcRect.w == 0) return;
+    SDL_RenderCopy(renderer, atlas, &srcRect, &dstRect);
+}
+
+// Creates the layer's texture on first use or when its size changes. False when
+// the renderer cannot draw into textures; the caller then draws to the screen.
+bool Renderer::prepareLayer(Layer& layer, int w, int h) {
+    if (layer.texture && layer.w == w && layer.h == h) {
+        return true;
+    }
+    freeLayer(layer);
+    if (!SDL_RenderTargetSupported(renderer)) {
+        return false;
+    }
+    layer.texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, w, h);
+    if (!layer.texture) {
+        return false;
+    }
+    // Glyphs blended onto a transparent layer come out premultiplied; the
+    // software renderer has no custom modes and falls back to plain blending
+    SDL_BlendMode premultiplied = SDL_ComposeCustomBlendMode(
+        SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+        SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD);
+    if (SDL_SetTextureBlendMode(layer.texture, premultiplied) != 0) {
+        SDL_SetTextureBlendMode(layer.texture, SDL_BLENDMODE_BLEND);
+    }
+    layer.w = w;
+    layer.h = h;
+    return true;
+}
+
+// Versions of different boards differ in their top 32 bits (see clearBoard)
+bool Renderer::layerIsStale(const Layer& layer, uint64_t version) const {
+    return layer.gridSize != gridSize || (layer.version >> 32) != (version >> 32);
+}
+
+void Renderer::drawLayer(const Layer& layer, int x, int y) {
+    SDL_Rect dstRect = {x, y, layer.w, layer.h};
+    SDL_RenderCopy(renderer, layer.texture, nullptr, &dstRect);
+}
+
+void Renderer::freeLayer(Layer& layer) {
+    if (layer.texture) {
+        SDL_DestroyTexture(layer.texture);
+    }
+    layer = Layer{};
+}
+
+void Renderer::releaseCaches() {
+    // Textures belong to the SDL renderer, so this goes before it does
+    if (atlas) {
+        SDL_DestroyTexture(atlas);
+        atlas = nullptr;
+    }
+    atlasFont = nullptr;
+    freeLayer(boardLayer);
+    freeLayer(tallyLayer);
+    if (labelTexture) {
+        SDL_DestroyTexture(labelTexture);
+        labelTexture = nullptr;
+    }
+    labelText.clear();
 }
 
 void Renderer::getGridPosition(int x, int y, int &row, int &col) {
-    row = (y - GRID_START_Y) / CELL_SIZE;
-    col = (x - GRID_START_X) / CELL_SIZE;
+    row = (y - GRID_START_Y) / cellSize;
+    col = (x - gridStartX) / cellSize;
 
     // Clamp values to be within grid bounds
     if (row < 0) row = 0;
-    if (row >= Sudoku::GRID_SIZE) row = Sudoku::GRID_SIZE - 1;
+    if (row >= gridSize) row = gridSize - 1;
     if (col < 0) col = 0;
-    if (col >= Sudoku::GRID_SIZE) col = Sudoku::GRID_SIZE - 1;
+    if (col >= gridSize) col = gridSize - 1;
 }
 
 void Renderer::renderSelectedCell(int row, int col) {
     // Hightlight row and col
-    SDL_Rect rowRect = {GRID_START_X, GRID_START_Y + row * CELL_SIZE, GRID_PIXELS, CELL_SIZE};    
-    SDL_Rect colRect = {GRID_START_X + col * CELL_SIZE, GRID_START_Y, CELL_SIZE, GRID_PIXELS};
+    SDL_Rect rowRect = {gridStartX, GRID_START_Y + row * cellSize, gridPixels, cellSize};    
+    SDL_Rect colRect = {gridStartX + col * cellSize, GRID_START_Y, cellSize, gridPixels};
 
-    // Highlight the 3x3 subgrid with yet another faint blue
+    // Highlight the subgrid with yet another faint blue
     SDL_SetRenderDrawColor(renderer, 210, 233, 253, 255); // Third very light blue
-    int subgridStartRow = (row / 3) * 3;
-    int subgridStartCol = (col / 3) * 3;
-    SDL_Rect subgridRect = {GRID_START_X + subgridStartCol * CELL_SIZE,GRID_START_Y + subgridStartRow * CELL_SIZE, CELL_SIZE * 3, CELL_SIZE * 3};
+    int subgridStartRow = (row / boxSize) * boxSize;
+    int subgridStartCol = (col / boxSize) * boxSize;
+    SDL_Rect subgridRect = {gridStartX + subgridStartCol * cellSize,GRID_START_Y + subgridStartRow * cellSize, cellSize * boxSize, cellSize * boxSize};
 
     SDL_RenderFillRect(renderer, &rowRect);
     SDL_RenderFillRect(renderer, &colRect);
@@ -230,68 +455,69 @@ void Renderer::renderSelectedCell(int row, int col) {
 
     // Highlight the selected cell with the original light blue color
     SDL_SetRenderDrawColor(renderer, 173, 216, 230, 255); // Original light blue
-    SDL_Rect selectedRect = {GRID_START_X + col * CELL_SIZE, GRID_START_Y + row * CELL_SIZE, CELL_SIZE, CELL_SIZE};
+    SDL_Rect selectedRect = {gridStartX + col * cellSize, GRID_START_Y + row * cellSize, cellSize, cellSize};
     SDL_RenderFillRect(renderer, &selectedRect);
 }
 
-void Renderer::renderNumberCounts(const Sudoku& sudoku) {
-    auto counts = calculateNumberCounts(sudoku);
-        
-    // Position the counter row just below the grid
-    const int COUNTER_Y = GRID_START_Y + GRID_PIXELS + 10;
-    
-    // Define colors for complete and incomplete numbers
-    for (int i = 0; i < 9; i++) {
-        SDL_Color color = (counts[i] == 9) ? SDL_Color{56, 87, 246, 255} : SDL_Color{0, 0, 0, 255};
-        
-        // Render main number (1-9) with bold style
-        TTF_SetFontStyle(font, TTF_STYLE_BOLD);
-        std::string numStr = std::to_string(i + 1);
-        SDL_Surface* numSurface = TTF_RenderText_Blended(font, numStr.c_str(), color);
-        if (!numSurface) continue;
-        
-        SDL_Texture* numTexture = SDL_CreateTextureFromSurface(renderer, numSurface);
-        if (!numTexture) {
-            SDL_FreeSurface(numSurface);
-            continue;
-        }
-        
+template <int Box>
+void Renderer::renderNumberCounts(const BasicSudoku<Box>& sudoku) {
+    if (!buildAtlas()) return;
+
+    // Position the counter row just below the grid. Its layer starts half a cell
+    // higher for the raised counts and is a cell wider for the last one
+    const int COUNTER_Y = GRID_START_Y + gridPixels + 10;
+    const int top = COUNTER_Y - cellSize / 2;
+    if (!prepareLayer(tallyLayer, gridPixels + cellSize, cellSize * 2)) {
+        renderTally(sudoku, gridStartX, COUNTER_Y);
+        return;
+    }
+
+    // Counts change only with the board, so the row is redrawn only when the version moves
+    uint64_t version = sudoku.getVersion();
+    if (layerIsStale(tallyLayer, version) || version != tallyLayer.version) {
+        SDL_SetRenderTarget(renderer, tallyLayer.texture);
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+        SDL_RenderClear(renderer);
+        renderTally(sudoku, 0, COUNTER_Y - top);
+        SDL_SetRenderTarget(renderer, nullptr);
+        tallyLayer.gridSize = gridSize;
+        tallyLayer.version = version;
+    }
+    drawLayer(tallyLayer, gridStartX, top);
+}
+
+// The digits 1-N in a row with their counts, the row's top-left corner at (x, y)
+template <int Box>
+void Renderer::renderTally(const BasicSudoku<Box>& sudoku, int x, int y) {
+    for (int i = 0; i < gridSize; i++) {
+        // Main number (1-N) in bold, blue once placed everywhere
+        int count = sudoku.getDigitCount(i + 1);
+        GlyphStyle style = (count == gridSize) ? GlyphStyle::TallyDone : GlyphStyle::Tally;
+
         // Center number in its cell
+        const SDL_Rect& glyph = glyphRects[static_cast<int>(style)][i + 1];
+        int numW = glyph.w, numH = glyph.h;
+        fitToCell(numW, numH);
         SDL_Rect numRect = {
-            GRID_START_X + i * CELL_SIZE + (CELL_SIZE - numSurface->w) / 2,
-            COUNTER_Y,
-            numSurface->w,
-            numSurface->h
+            x + i * cellSize + (cellSize - numW) / 2,
+            y,
+            numW,
+            numH
         };
-        SDL_RenderCopy(renderer, numTexture, nullptr, &numRect);
-        
-        // Render frequency count as tiny superscript
-        if (counts[i] < 9) {
-            TTF_SetFontStyle(font, TTF_STYLE_NORMAL);
-            std::string countStr = std::to_string(counts[i]);
-            SDL_Surface* countSurface = TTF_RenderText_Blended(font, countStr.c_str(), color);
-            if (countSurface) {
-                SDL_Texture* countTexture = SDL_CreateTextureFromSurface(renderer, countSurface);
-                if (countTexture) {
-                    // Position and size the superscript
-                    SDL_Rect countRect = {
-                        numRect.x + numRect.w - 2,        // Slightly overlapping with number
-                        numRect.y - numRect.h / 4,          // Raised above the baseline
-                        static_cast<int>(countSurface->w * 0.5),  // Make it 50% of original size
-                        static_cast<int>(countSurface->h * 0.5)
-                    };
-                    SDL_RenderCopy(renderer, countTexture, nullptr, &countRect);
-                    SDL_DestroyTexture(countTexture);
-                }
-                SDL_FreeSurface(countSurface);
+        drawGlyph(style, i + 1, numRect);
+
+        if (count < gridSize) {
+            // Frequency count as a superscript while the digit is missing, at 50% size
+            int countX = numRect.x + numRect.w - 2;     // Slightly overlapping with number
+            int countY = numRect.y - numRect.h / 4;     // Raised above the baseline
+            for (char c : std::to_string(count)) {
+                const SDL_Rect& digit = glyphRects[static_cast<int>(GlyphStyle::Fixed)][c - '0'];
+                SDL_Rect countRect = {countX, countY, digit.w / 2, digit.h / 2};
+                drawGlyph(GlyphStyle::Fixed, c - '0', countRect);
+                countX += countRect.w;
             }
         }
-        
-        SDL_FreeSurface(numSurface);
-        SDL_DestroyTexture(numTexture);
     }
-    
-    TTF_SetFontStyle(font, TTF_STYLE_NORMAL);
 }
 
 void Renderer::renderText(const std::string& text, int x, int y, SDL_Color color) {
@@ -310,6 +536,15 @@ void Renderer::renderText(const std::string& text, int x, int y, SDL_Color color
     SDL_DestroyTexture(texture);
 }
 
+void Renderer::fitToCell(int& w, int& h) const {
+    // Glyphs keep the 9x9 font; shrink them on the smaller cells of big boards
+    int limit = cellSize * 4 / 5;
+    if (h > limit) {
+        w = w * limit / h;
+        h = limit;
+    }
+}
+
 void Renderer::renderTimer(int elapsedSeconds) {
     // Calculate minutes and seconds
     int minutes = elapsedSeconds / 60;
@@ -325,6 +560,93 @@ void Renderer::renderTimer(int elapsedSeconds) {
     renderText(ss.str(), 20, 10, color);
 }
 
+void Renderer::setPuzzleId(const std::string& id) {
+    if (!window) return;
+    std::string title = id.empty() ? "sUdOkU" : "sUdOkU #" + id;
+    SDL_SetWindowTitle(window, title.c_str());
+}
+
+void Renderer::renderRating() {
+    const std::string& label = hint.kind != HintKind::None ? hintLabel : ratingLabel;
+    if (label.empty() || !font) return;
+
+    // The text only changes with setRating or a hint, so most frames just blit
+    if (!labelTexture || label != labelText) {
+        if (labelTexture) {
+            SDL_DestroyTexture(labelTexture);
+            labelTexture = nullptr;
+        }
+        SDL_Surface* surface = TTF_RenderText_Blended(font, label.c_str(), {0, 0, 0, 255});
+        if (!surface) return;
+        labelTexture = SDL_CreateTextureFromSurface(renderer, surface);
+        labelW = surface->w;
+        labelH = surface->h;
+        SDL_FreeSurface(surface);
+        if (!labelTexture) return;
+        labelText = label;
+    }
+
+    // Right-aligned in the top padding, opposite the timer
+    SDL_Rect dstRect = {WINDOW_WIDTH - 20 - labelW, 10, labelW, labelH};
+    SDL_RenderCopy(renderer, labelTexture, nullptr, &dstRect);
+}
+
+#ifdef SUDOKU_STATS
+// Debug overlay: the solver work behind the puzzle on screen
+void Renderer::renderStats(const SolverStats& stats) {
+    std::ostringstream lines[4];
+    lines[0] << "nodes " << stats.nodes << "  backtracks " << stats.backtracks;
+    lines[1] << "propagations " << stats.propagations;
+    lines[2] << "checks " << stats.uniquenessChecks << "  restored " << stats.cellsRestored;
+    lines[3] << "fill " << stats.fillMicros << "us  remove " << stats.removeMicros << "us  solve " << stats.solveMicros << "us";
+
+    const int lineHeight = 28;
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 220);
+    SDL_Rect panel = {gridStartX, GRID_START_Y, gridPixels, 4 * lineHeight + 10};
+    SDL_RenderFillRect(renderer, &panel);
+    for (int i = 0; i < 4; i++) {
+        renderText(lines[i].str(), gridStartX + 10, GRID_START_Y + 5 + i * lineHeight, {120, 0, 120, 255});
+    }
+}
+#endif
+
+void Renderer::setHint(const Hint& shown) {
+    hint = shown;
+    hintLabel = shown.describe();
+}
+
+void Renderer::renderHint() {
+    if (hint.kind == HintKind::None || gridSize != SudokuTables::GRID_SIZE) return;
+
+    auto fillCell = [this](int cell, SDL_Color color) {
+        SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, 255);
+        SDL_Rect rect = {gridStartX + SUDOKU_TABLES.colOf[cell] * cellSize,
+                         GRID_START_Y + SUDOKU_TABLES.rowOf[cell] * cellSize, cellSize, cellSize};
+        SDL_RenderFillRect(renderer, &rect);
+    };
+
+    if (hint.kind == HintKind::Mistakes) {
+        for (int cell = 0; cell < SudokuTables::CELL_COUNT; cell++) {
+            if (hint.mistakes[cell]) fillCell(cell, {255, 200, 200, 255});   // Pale red
+        }
+        return;
+    }
+    if (hint.kind != HintKind::Step) return;
+
+    // Cells that justify the step in pale yellow, the cells it changes on top
+    for (int i = 0; i < hint.step.patternSize; i++) {
+        fillCell(hint.step.pattern[i], {255, 243, 176, 255});
+    }
+    if (hint.step.isPlacement()) {
+        fillCell(hint.step.cell, {190, 235, 190, 255});   // Pale green
+    } else {
+        for (int cell = 0; cell < SudokuTables::CELL_COUNT; cell++) {
+            if (hint.step.affected[cell]) fillCell(cell, {255, 214, 170, 255});   // Pale orange
+        }
+    }
+}
+
 void Renderer::renderVictoryScreen(int elapsedSeconds) {
     // Clear screen with white background
     SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
@@ -699,27 +1021,17 @@ int Renderer::handleDifficultyClick(int x, int y) {
     return 0;
 }
 
-std::array<int, 9> Renderer::calculateNumberCounts(const Sudoku& sudoku) const {
-    std::array<int, 9> counts = {0};
-    for (int row = 0; row < Sudoku::GRID_SIZE; row++) {
-        for (int col = 0; col < Sudoku::GRID_SIZE; col++) {
-            int number = sudoku.getNumber(row, col);
-            if (number != 0) {
-                counts[number - 1]++;
-            }
-        }
-    }
-    return counts;
-}
+template <int Box>
+void Renderer::completeEffect(const BasicSudoku<Box>& sudoku, int originRow, int originCol, int durationMs) {
+    setLayout(Box);
 
-void Renderer::completeEffect(const Sudoku& sudoku, int originRow, int originCol, int durationMs) {
     // origin center in pixels
-    const double originCx = GRID_START_X + originCol * CELL_SIZE + CELL_SIZE / 2.0;
-    const double originCy = GRID_START_Y + originRow * CELL_SIZE + CELL_SIZE / 2.0;
+    const double originCx = gridStartX + originCol * cellSize + cellSize / 2.0;
+    const double originCy = GRID_START_Y + originRow * cellSize + cellSize / 2.0;
 
     // maximum radius to cover grid corners
-    double maxDx = std::max(originCx - GRID_START_X, GRID_START_X + GRID_PIXELS - originCx);
-    double maxDy = std::max(originCy - GRID_START_Y, GRID_START_Y + GRID_PIXELS - originCy);
+    double maxDx = std::max(originCx - gridStartX, gridStartX + gridPixels - originCx);
+    double maxDy = std::max(originCy - GRID_START_Y, GRID_START_Y + gridPixels - originCy);
     double maxRadius = std::sqrt(maxDx * maxDx + maxDy * maxDy) + 1.0;
 
     const int frameDelayMs = 16;
@@ -740,7 +1052,7 @@ void Renderer::completeEffect(const Sudoku& sudoku, int originRow, int originCol
         SDL_Rect bottomPadding = {0, WINDOW_HEIGHT - 50, WINDOW_WIDTH, 50}; SDL_RenderFillRect(renderer, &bottomPadding);
         SDL_Rect rightPadding = {WINDOW_WIDTH - 50, 0, 50, WINDOW_HEIGHT}; SDL_RenderFillRect(renderer, &rightPadding);
 
-        renderTimer(Game::getElapsedSeconds());
+        renderTimer(BasicGame<Box>::getElapsedSeconds());
         renderGrid();
         renderNumbers(sudoku);
         renderNumberCounts(sudoku);
@@ -751,10 +1063,10 @@ void Renderer::completeEffect(const Sudoku& sudoku, int originRow, int originCol
         const double thickness = 40.0; // thickness of the ring in pixels
 
         // For each cell compute center distance and draw overlay if within ring
-        for (int row = 0; row < Sudoku::GRID_SIZE; ++row) {
-            for (int col = 0; col < Sudoku::GRID_SIZE; ++col) {
-                double cx = GRID_START_X + col * CELL_SIZE + CELL_SIZE / 2.0;
-                double cy = GRID_START_Y + row * CELL_SIZE + CELL_SIZE / 2.0;
+        for (int row = 0; row < gridSize; ++row) {
+            for (int col = 0; col < gridSize; ++col) {
+                double cx = gridStartX + col * cellSize + cellSize / 2.0;
+                double cy = GRID_START_Y + row * cellSize + cellSize / 2.0;
                 double dx = cx - originCx;
                 double dy = cy - originCy;
                 double d = std::sqrt(dx*dx + dy*dy);
@@ -768,7 +1080,7 @@ void Renderer::completeEffect(const Sudoku& sudoku, int originRow, int originCol
                     Uint8 alpha = static_cast<Uint8>(80 + intensity * 175); // 80..255
                     SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
                     SDL_SetRenderDrawColor(renderer, 203, 220, 235, alpha);
-                    SDL_Rect cellRect = { GRID_START_X + col * CELL_SIZE, GRID_START_Y + row * CELL_SIZE, CELL_SIZE, CELL_SIZE };
+                    SDL_Rect cellRect = { gridStartX + col * cellSize, GRID_START_Y + row * cellSize, cellSize, cellSize };
                     SDL_RenderFillRect(renderer, &cellRect);
                 }
             }
@@ -777,4 +1089,11 @@ void Renderer::completeEffect(const Sudoku& sudoku, int originRow, int originCol
         SDL_RenderPresent(renderer);
         SDL_Delay(frameDelayMs);
     }
-}
\ No newline at end of file
+}
+
+template void Renderer::render(const BasicSudoku<3>&, int, int);
+template void Renderer::render(const BasicSudoku<4>&, int, int);
+template void Renderer::render(const BasicSudoku<5>&, int, int);
+template void Renderer::completeEffect(const BasicSudoku<3>&, int, int, int);
+template void Renderer::completeEffect(const BasicSudoku<4>&, int, int, int);
+template void Renderer::completeEffect(const BasicSudoku<5>&, int, int, int);
@@ -0,0 +1,345 @@
+#include "solver.h"
+#include "dlx_solver.h"
+#include <algorithm>
+
+namespace {
+
+template <typename Mask>
+int lowestDigit(Mask bits) {
+    return __builtin_ctzll(bits) + 1;
+}
+
+} // namespace
+
+template <int Box>
+BasicBacktrackingSolver<Box>::BasicBacktrackingSolver(Rng* rng)
+    : rng(rng), firstSolution(nullptr), solutionLimit(1), solutionCount(0), nodeLimit(0), nodeCount(0) {}
+
+template <int Box>
+int BasicBacktrackingSolver<Box>::solve(Grid& grid, int limit) {
+    firstSolution = &grid;
+    solutionLimit = limit;
+    solutionCount = 0;
+    nodeCount = 0;
+
+    State state;
+    if (load(state, grid)) {
+        search(state);
+    }
+    return solutionCount;
+}
+
+template <int Box>
+bool BasicBacktrackingSolver<Box>::load(State& state, const Grid& grid) {
+    state.grid.fill(0);
+    state.candidates.fill(Tables::ALL_DIGITS);
+    for (int cell = 0; cell < Tables::CELL_COUNT; cell++) {
+        if (grid[cell] == 0) continue;
+
+        // A given that is no longer a candidate clashes with an earlier one
+        if ((state.candidates[cell] & (Mask(1) << (grid[cell] - 1))) == 0 || !assign(state, cell, grid[cell])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <int Box>
+bool BasicBacktrackingSolver<Box>::assign(State& state, int cell, int num) {
+    Mask bit = Mask(1) << (num - 1);
+    state.grid[cell] = static_cast<uint8_t>(num);
+    state.candidates[cell] = 0;
+
+    for (auto peer : BASIC_SUDOKU_TABLES<Box>.peers[cell]) {
+        if (state.candidates[peer] & bit) {
+            state.candidates[peer] &= ~bit;
+            if (state.candidates[peer] == 0) {
+                return false; // an empty peer has nothing left
+            }
+        }
+    }
+    return true;
+}
+
+template <int Box>
+bool BasicBacktrackingSolver<Box>::propagate(State& state) {
+    bool changed = true;
+    while (changed) {
+        changed = false;
+
+        // Naked singles: a cell with one candidate left
+        for (int cell = 0; cell < Tables::CELL_COUNT; cell++) {
+            Mask candidates = state.candidates[cell];
+            if (candidates != 0 && (candidates & (candidates - 1)) == 0) {
+                SUDOKU_STAT(propagations, 1);
+                if (!assign(state, cell, lowestDigit(candidates))) return false;
+                changed = true;
+            }
+        }
+
+        // Hidden singles: a digit with one place left in a unit
+        for (const auto& unit : BASIC_SUDOKU_TABLES<Box>.units) {
+            Mask once = 0, twice = 0, placed = 0;
+            for (auto cell : unit) {
+                Mask candidates = state.candidates[cell];
+                twice |= once & candidates;
+                once |= candidates;
+                if (state.grid[cell] != 0) placed |= Mask(1) << (state.grid[cell] - 1);
+            }
+            if ((once | placed) != Tables::ALL_DIGITS) {
+                return false; // some digit has nowhere to go
+            }
+
+            Mask hidden = once & ~twice;
+            while (hidden) {
+                Mask bit = hidden & -hidden;
+                hidden &= hidden - 1;
+
+                // An earlier placement in this unit may already have taken the only cell
+                int target = -1;
+                for (auto cell : unit) {
+                    if (state.candidates[cell] & bit) target = cell;
+                }
+                SUDOKU_STAT(propagations, 1);
+                if (target == -1 || !assign(state, target, lowestDigit(bit))) return false;
+                changed = true;
+            }
+        }
+
+        // Singles alone leave big boards with deep searches; 9x9 is faster without this
+        if constexpr (Box > 3) {
+            if (!changed && !eliminateLocked(state, changed)) return false;
+        }
+    }
+    return true;
+}
+
+template <int Box>
+bool BasicBacktrackingSolver<Box>::eliminateLocked(State& state, bool& changed) {
+    const auto& tables = BASIC_SUDOKU_TABLES<Box>;
+    const int N = Tables::GRID_SIZE;
+
+    auto strip = [&state, &changed](int cell, Mask digits) {
+        if ((state.candidates[cell] & digits) == 0) return true;
+        state.candidates[cell] &= ~digits;
+        changed = true;
+        return state.candidates[cell] != 0;
+    };
+
+    // Candidates of each box split by the box's rows and columns; a digit that
+    // appears in only one of them is locked there and leaves the rest of the line
+    for (int box = 0; box < N; box++) {
+        Mask rowPart[Box] = {}, colPart[Box] = {};
+        for (int j = 0; j < N; j++) {
+            Mask candidates = state.candidates[tables.units[2 * N + box][j]];
+            rowPart[j / Box] |= candidates;
+            colPart[j % Box] |= candidates;
+        }
+        for (int i = 0; i < Box; i++) {
+            Mask otherRows = 0, otherCols = 0;
+            for (int k = 0; k < Box; k++) {
+                if (k == i) continue;
+                otherRows |= rowPart[k];
+                otherCols |= colPart[k];
+            }
+            Mask rowLocked = rowPart[i] & ~otherRows;
+            Mask colLocked = colPart[i] & ~otherCols;
+            int row = (box / Box) * Box + i;
+            int col = (box % Box) * Box + i;
+            for (int j = 0; j < N; j++) {
+                if (rowLocked && j / Box != box % Box && !strip(tables.units[row][j], rowLocked)) return false;
+                if (colLocked && j / Box != box / Box && !strip(tables.units[N + col][j], colLocked)) return false;
+            }
+        }
+    }
+
+    // The same per line: a digit confined to one box segment leaves the rest of that box
+    for (int line = 0; line < 2 * N; line++) {
+        Mask segment[Box] = {};
+        for (int j = 0; j < N; j++) {
+            segment[j / Box] |= state.candidates[tables.units[line][j]];
+        }
+        for (int k = 0; k < Box; k++) {
+            Mask others = 0;
+            for (int m = 0; m < Box; m++) {
+                if (m != k) others |= segment[m];
+            }
+            Mask locked = segment[k] & ~others;
+            if (!locked) continue;
+
+            bool isRow = line < N;
+            int index = isRow ? line : line - N;
+            int box = isRow ? (index / Box) * Box + k : k * Box + index / Box;
+            for (int j = 0; j < N; j++) {
+                int cell = tables.units[2 * N + box][j];
+                bool onLine = isRow ? tables.rowOf[cell] == index : tables.colOf[cell] == index;
+                if (!onLine && !strip(cell, locked)) return false;
+            }
+        }
+    }
+    return true;
+}
+
+template <int Box>
+int BasicBacktrackingSolver<Box>::findBranch(const State& state, Choice* choices) {
+    // Branch on the empty cell with the fewest candidates
+    int cell = -1;
+    int bestCount = Tables::GRID_SIZE + 1;
+    for (int i = 0; i < Tables::CELL_COUNT; i++) {
+        if (state.grid[i] != 0) continue;
+
+        int count = __builtin_popcountll(state.candidates[i]);
+        if (count < bestCount) {
+            cell = i;
+            bestCount = count;
+            if (count <= 2) break;
+        }
+    }
+    if (cell == -1) {
+        return -1;
+    }
+
+    // On big boards a digit with few places left in a unit often beats the best cell
+    if constexpr (Box > 3) {
+        if (bestCount > 2) {
+            const auto& tables = BASIC_SUDOKU_TABLES<Box>;
+            int bestUnit = -1, bestDigit = 0;
+            for (int unit = 0; unit < Tables::UNIT_COUNT; unit++) {
+                for (int num = 1; num <= Tables::GRID_SIZE; num++) {
+                    Mask bit = Mask(1) << (num - 1);
+                    int places = 0;
+                    for (auto c : tables.units[unit]) places += (state.candidates[c] & bit) != 0;
+                    if (places > 0 && places < bestCount) {
+                        bestCount = places;
+                        bestUnit = unit;
+                        bestDigit = num;
+                    }
+                }
+            }
+            if (bestUnit >= 0) {
+                int count = 0;
+                for (auto c : tables.units[bestUnit]) {
+                    if (state.candidates[c] & (Mask(1) << (bestDigit - 1))) choices[count++] = {c, bestDigit};
+                }
+                return count;
+            }
+        }
+    }
+
+    int count = 0;
+    for (int num = 1; num <= Tables::GRID_SIZE; num++) {
+        if (state.candidates[cell] & (Mask(1) << (num - 1))) choices[count++] = {cell, num};
+    }
+    return count;
+}
+
+template <int Box>
+bool BasicBacktrackingSolver<Box>::search(State& state) {
+    if (nodeLimit != 0 && ++nodeCount > nodeLimit) {
+        return true; // unwind; the caller sees hitNodeLimit()
+    }
+    SUDOKU_STAT(nodes, 1);
+    if (!propagate(state)) {
+        return false;
+    }
+
+    Choice choices[Tables::GRID_SIZE];
+    int count = findBranch(state, choices);
+    if (count < 0) {
+        if (++solutionCount == 1) {
+            *firstSolution = state.grid;
+        }
+        return solutionCount >= solutionLimit;
+    }
+    if (rng) {
+        rng->shuffle(choices, choices + count);
+    }
+
+    for (int i = 0; i < count; i++) {
+        State next = state;
+        if (assign(next, choices[i].cell, choices[i].num) && search(next)) {
+            return true;
+        }
+        SUDOKU_STAT(backtracks, 1);
+    }
+    return false;
+}
+
+template <int Box>
+void BasicBacktrackingSolver<Box>::beginRemoval(const Grid& solution) {
+    removalSolution = solution;
+    removalBase.grid = solution;
+    removalBase.candidates.fill(0);
+}
+
+template <int Box>
+bool BasicBacktrackingSolver<Box>::tryRemove(const int* cells, int count) {
+    const auto& tables = BASIC_SUDOKU_TABLES<Box>;
+    auto heldByPeer = [&tables](const State& state, int cell, int num) {
+        for (auto peer : tables.peers[cell]) {
+            if (state.grid[peer] == num) return true;
+        }
+        return false;
+    };
+
+    // Widen the previous step's mask board instead of rebuilding it: the emptied cells
+    // get every digit no peer holds, and their empty peers get back the digit they lost
+    State next = removalBase;
+    for (int i = 0; i < count; i++) {
+        next.grid[cells[i]] = 0;
+    }
+    for (int i = 0; i < count; i++) {
+        int cell = cells[i];
+        Mask candidates = 0;
+        for (int num = 1; num <= Tables::GRID_SIZE; num++) {
+            if (!heldByPeer(next, cell, num)) candidates |= Mask(1) << (num - 1);
+        }
+        next.candidates[cell] = candidates;
+
+        int num = removalSolution[cell];
+        for (auto peer : tables.peers[cell]) {
+            if (next.grid[peer] == 0 && !heldByPeer(next, peer, num)) {
+                next.candidates[peer] |= Mask(1) << (num - 1);
+            }
+        }
+    }
+
+    // Any second solution differs from the known one in an emptied cell, so it is
+    // enough to forbid the known digit there, one cell at a time; most of these
+    // searches die in propagation
+    Grid scratch;
+    for (int i = 0; i < count; i++) {
+        int cell = cells[i];
+        State trial = next;
+        trial.candidates[cell] &= ~(Mask(1) << (removalSolution[cell] - 1));
+        if (trial.candidates[cell] == 0) continue;
+
+        firstSolution = &scratch;
+        solutionLimit = 1;
+        solutionCount = 0;
+        nodeCount = 0;
+        search(trial);
+        if (solutionCount > 0 || hitNodeLimit()) {
+            return false;
+        }
+    }
+    removalBase = next;
+    return true;
+}
+
+template class BasicBacktrackingSolver<3>;
+template class BasicBacktrackingSolver<4>;
+template class BasicBacktrackingSolver<5>;
+
+Solver& getSolver(SolverEngine engine) {
+    thread_local BacktrackingSolver backtracking;
+    thread_local DlxSolver dancingLinks;
+
+    if (engine == SolverEngine::DancingLinks) {
+        return dancingLinks;
+    }
+    if (engine == SolverEngine::Parallel) {
+        return getParallelSolver<3>();
+    }
+    return backtracking;
+}
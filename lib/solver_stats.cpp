@@ -0,0 +1,33 @@
+#include "solver_stats.h"
+
+SolverStats& SolverStats::operator+=(const SolverStats& other) {
+    nodes += other.nodes;
+    backtracks += other.backtracks;
+    propagations += other.propagations;
+    uniquenessChecks += other.uniquenessChecks;
+    cellsRestored += other.cellsRestored;
+    fillMicros += other.fillMicros;
+    removeMicros += other.removeMicros;
+    solveMicros += other.solveMicros;
+    return *this;
+}
+
+SolverStats SolverStats::operator-(const SolverStats& other) const {
+    SolverStats result;
+    result.nodes = nodes - other.nodes;
+    result.backtracks = backtracks - other.backtracks;
+    result.propagations = propagations - other.propagations;
+    result.uniquenessChecks = uniquenessChecks - other.uniquenessChecks;
+    result.cellsRestored = cellsRestored - other.cellsRestored;
+    result.fillMicros = fillMicros - other.fillMicros;
+    result.removeMicros = removeMicros - other.removeMicros;
+    result.solveMicros = solveMicros - other.solveMicros;
+    return result;
+}
+
+#ifdef SUDOKU_STATS
+SolverStats& threadSolverStats() {
+    thread_local SolverStats stats;
+    return stats;
+}
+#endif
@@ -1,246 +1,602 @@
 #include "sudoku.h"
+#include "puzzle_db.h"
+#include <atomic>
 #include <iostream>
+#include <numeric>
 
-Sudoku::Sudoku() : grid(GRID_SIZE, std::vector<int>(GRID_SIZE, 0)),
-                   fixed(GRID_SIZE, std::vector<bool>(GRID_SIZE, false)) {
-    std::srand(static_cast<unsigned int>(std::time(nullptr))); // Seed for randomness
+namespace {
+
+// Crockford's base32: no I, L, O or U, so IDs survive being read out or retyped
+const char ID_DIGITS[] = "0123456789ABCDEFGHJKMNPQRSTVWXYZ";
+const int ID_SEED_CHARS = 13;   // 64 bits, 5 per character
+const char SYMMETRY_TAGS[] = " RM";   // ID letter per Symmetry, none for Symmetry::None
+
+int idDigitValue(char c) {
+    if (c >= 'a' && c <= 'z') c = static_cast<char>(c - 'a' + 'A');
+    if (c == 'O') c = '0';
+    if (c == 'I' || c == 'L') c = '1';
+    for (int i = 0; i < 32; i++) {
+        if (ID_DIGITS[i] == c) return i;
+    }
+    return -1;
+}
+
+int symmetryTagValue(char c) {
+    if (c >= 'a' && c <= 'z') c = static_cast<char>(c - 'a' + 'A');
+    for (int i = 1; SYMMETRY_TAGS[i] != '\0'; i++) {
+        if (SYMMETRY_TAGS[i] == c) return i;
+    }
+    return -1;
+}
+
+// Each cleared board starts its version at a fresh multiple of 2^32, so versions
+// seen by a view never repeat even across boards built on different threads
+std::atomic<uint64_t> boardEpochs{0};
+
+} // namespace
+
+template <int Box>
+BasicSudoku<Box>::BasicSudoku() : BasicSudoku(EmptyBoard()) {
     generatePuzzle(2); // default to Medium
 }
 
-void Sudoku::generatePuzzle(int difficulty) {
-    // Start with an empty grid
-    for(auto& row : grid) {
-        std::fill(row.begin(), row.end(), 0);
+template <int Box>
+BasicSudoku<Box>::BasicSudoku(EmptyBoard)
+    : cells{}, rowMask{}, colMask{}, boxMask{}, digitCount{}, conflictBits{}, conflictCount(0), filledCount(0), digitTotal{}, version(0), dirtyBits{}, notes{}, solverEngine(SolverEngine::Backtracking), symmetry(Symmetry::None), puzzleSeed(0), puzzleDifficulty(0), puzzleSymmetry(Symmetry::None) {
+    clearBoard(); // a fresh version with every cell dirty, like any new board
+}
+
+template <int Box>
+void BasicSudoku<Box>::generatePuzzle(int difficulty) {
+    generatePuzzle(difficulty, Rng::freshSeed());
+}
+
+template <int Box>
+void BasicSudoku<Box>::generatePuzzle(int difficulty, uint64_t seed) {
+    // Every random choice below comes from this one generator, so the seed alone
+    // (with difficulty and board size) pins the puzzle down
+    Rng rng(seed);
+    SUDOKU_STAT_CAPTURE(stats);
+    auto randomUpTo = [&rng](int n) { return static_cast<int>(rng.below(n)); };
+
+    // Determine how many cells to remove based on difficulty. The bands are given
+    // for 81 cells; removal stalls near 74% blanks on 9x9 but ~62% on 16x16 and
+    // ~56% on 25x25, so bigger boards squeeze them under what they can reach.
+    const int reachOf81 = Box == 3 ? 61 : (Box == 4 ? 51 : 45);
+    auto scaled = [reachOf81](int removalsOf81) { return removalsOf81 * reachOf81 * CELL_COUNT / (61 * 81); };
+    int cellsToRemove = 0;
+    int minRemovals = 0;
+    if (difficulty <= 1) {
+        // Easy: fewer removals (more clues)
+        minRemovals = scaled(36);
+        cellsToRemove = minRemovals + randomUpTo(scaled(45) - minRemovals); // 36..44
+    } else if (difficulty == 2) {
+        // Medium: previous behavior
+        minRemovals = scaled(45);
+        cellsToRemove = minRemovals + randomUpTo(scaled(56) - minRemovals); // 45..55
+    } else {
+        // Hard: more removals (fewer clues)
+        minRemovals = scaled(56);
+        cellsToRemove = minRemovals + randomUpTo(scaled(61) - minRemovals); // 56..60
+    }
+
+    // Not every solution grid admits a unique puzzle that sparse, so start
+    // over from a fresh grid when removal stalls below the difficulty band
+    for (int attempt = 0; attempt < MAX_GENERATE_ATTEMPTS; attempt++) {
+        fillSolutionGrid(rng);
+        if (removeCells(cellsToRemove, rng) >= minRemovals) {
+            break;
+        }
+    }
+    puzzleSeed = seed;
+    puzzleDifficulty = difficulty;
+    puzzleSymmetry = symmetry;
+}
+
+template <int Box>
+std::string BasicSudoku<Box>::getPuzzleId() const {
+    if (puzzleSeed == 0) {
+        return "";
+    }
+    std::string id;
+    if (GRID_SIZE != 9) {
+        id = std::to_string(GRID_SIZE) + "x" + std::to_string(GRID_SIZE) + "-";
+    }
+    id += std::to_string(puzzleDifficulty);
+    if (puzzleSymmetry != Symmetry::None) {
+        id += SYMMETRY_TAGS[static_cast<int>(puzzleSymmetry)];
+    }
+    id += "-";
+    for (int i = ID_SEED_CHARS - 1; i >= 0; i--) {
+        id += ID_DIGITS[(puzzleSeed >> (5 * i)) & 31];
+    }
+    return id;
+}
+
+template <int Box>
+bool BasicSudoku<Box>::generateFromId(const std::string& id) {
+    std::string rest = id;
+    if (GRID_SIZE != 9) {
+        std::string prefix = std::to_string(GRID_SIZE) + "x" + std::to_string(GRID_SIZE) + "-";
+        if (rest.compare(0, prefix.size(), prefix) != 0) {
+            return false;
+        }
+        rest = rest.substr(prefix.size());
+    }
+    Symmetry pattern = Symmetry::None;
+    if (rest.size() == 3 + ID_SEED_CHARS) {
+        int tag = symmetryTagValue(rest[1]);
+        if (tag < 0) {
+            return false;
+        }
+        pattern = static_cast<Symmetry>(tag);
+        rest.erase(1, 1);
     }
-    for(auto& row : fixed) {
-        std::fill(row.begin(), row.end(), false);
+    if (rest.size() != 2 + ID_SEED_CHARS || rest[0] < '1' || rest[0] > '3' || rest[1] != '-') {
+        return false;
+    }
+
+    uint64_t seed = 0;
+    for (int i = 0; i < ID_SEED_CHARS; i++) {
+        int value = idDigitValue(rest[2 + i]);
+        if (value < 0 || (i == 0 && value > 15)) {
+            return false; // the leading character only carries 4 bits
+        }
+        seed = (seed << 5) | static_cast<uint64_t>(value);
     }
+    if (seed == 0) {
+        return false;
+    }
+    Symmetry previous = symmetry;
+    symmetry = pattern;
+    generatePuzzle(rest[0] - '0', seed);
+    symmetry = previous;
+    return true;
+}
+
+template <int Box>
+void BasicSudoku<Box>::clearBoard() {
+    cells.fill(0);
+    std::fill(std::begin(rowMask), std::end(rowMask), 0);
+    std::fill(std::begin(colMask), std::end(colMask), 0);
+    std::fill(std::begin(boxMask), std::end(boxMask), 0);
+    std::fill(&digitCount[0][0], &digitCount[0][0] + UNIT_COUNT * (GRID_SIZE + 1), 0);
+    std::fill(std::begin(conflictBits), std::end(conflictBits), 0);
+    conflictCount = 0;
+    filledCount = 0;
+    std::fill(std::begin(digitTotal), std::end(digitTotal), 0);
+    version = (boardEpochs.fetch_add(1, std::memory_order_relaxed) + 1) << 32;
+    std::fill(std::begin(dirtyBits), std::end(dirtyBits), ~uint64_t(0));
+    std::fill(std::begin(notes), std::end(notes), 0);
+#ifdef SUDOKU_STATS
+    stats = SolverStats();
+#endif
+    puzzleSeed = 0;
+    puzzleDifficulty = 0;
+    puzzleSymmetry = Symmetry::None;
+}
+
+template <int Box>
+void BasicSudoku<Box>::fillSolutionGrid(Rng& rng) {
+    SUDOKU_STAT_TIMER(fillMicros);
+    // Start with an empty grid
+    clearBoard();
 
     // Fill diagonal subgrids
     for (int box = 0; box < GRID_SIZE; box += SUBGRID_SIZE) {
-        // Generate random permutation of numbers 1-9
+        // Generate random permutation of numbers 1-N
         std::vector<int> nums(GRID_SIZE);
         std::iota(nums.begin(), nums.end(), 1);
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        std::shuffle(nums.begin(), nums.end(), gen);
+        rng.shuffle(nums.begin(), nums.end());
         
         for (int i = 0; i < SUBGRID_SIZE; i++) {
             for (int j = 0; j < SUBGRID_SIZE; j++) {
-                grid[box + i][box + j] = nums[i * SUBGRID_SIZE + j];
+                placeDigit(cellIndex(box + i, box + j), nums[i * SUBGRID_SIZE + j]);
             }
         }
     }
 
-    solveGrid();
+    solveGrid(rng);
 
     // Mark all cells as fixed
-    for(auto& row : fixed) {
-        std::fill(row.begin(), row.end(), true);
+    for (auto& cell : cells) {
+        cell |= FIXED_FLAG;
     }
+}
 
-    // Determine how many cells to remove based on difficulty
-    int cellsToRemove = 0;
-    if (difficulty <= 1) {
-        // Easy: fewer removals (more clues)
-        cellsToRemove = 36 + (std::rand() % 9); // 36..44
-    } else if (difficulty == 2) {
-        // Medium: previous behavior
-        cellsToRemove = 45 + (std::rand() % 11); // 45..55
-    } else {
-        // Hard: more removals (fewer clues)
-        cellsToRemove = 56 + (std::rand() % 5); // 56..60
+template <int Box>
+bool BasicSudoku<Box>::loadPuzzle(const std::string& text) {
+    if (text.size() != CELL_COUNT) {
+        return false;
+    }
+    for (char c : text) {
+        if (symbolDigit(c) == 0 && c != '.' && c != '0') {
+            return false;
+        }
+    }
+
+    clearBoard();
+
+    for (int cell = 0; cell < CELL_COUNT; cell++) {
+        int num = symbolDigit(text[cell]);
+        if (num != 0) {
+            placeDigit(cell, num);
+            cells[cell] |= FIXED_FLAG;
+        }
+    }
+    return true;
+}
+
+template <int Box>
+int BasicSudoku<Box>::symbolDigit(char c) {
+    int num = 0;
+    if (c >= '1' && c <= '9') {
+        num = c - '0';
+    } else if (c >= 'A' && c <= 'Z') {
+        num = c - 'A' + 10;
+    } else if (c >= 'a' && c <= 'z') {
+        num = c - 'a' + 10;
     }
+    return num <= GRID_SIZE ? num : 0;
+}
+
+template <int Box>
+template <int B, typename>
+void BasicSudoku<Box>::loadPacked(const PackedPuzzle& puzzle) {
+    clearBoard();
+    for (int cell = 0; cell < CELL_COUNT; cell++) {
+        int num = puzzle.getCell(cell);
+        if (num >= 1 && num <= GRID_SIZE) {
+            placeDigit(cell, num);
+            cells[cell] |= FIXED_FLAG;
+        }
+    }
+    puzzleSeed = puzzle.seed;
+    puzzleDifficulty = puzzle.difficulty;
+    puzzleSymmetry = puzzle.symmetry <= static_cast<uint8_t>(Symmetry::Mirror) ? static_cast<Symmetry>(puzzle.symmetry) : Symmetry::None;
+}
+
+template <int Box>
+template <int B, typename>
+PackedPuzzle BasicSudoku<Box>::pack(int difficulty) const {
+    PackedPuzzle puzzle = {};
+    puzzle.seed = puzzleSeed;
+    puzzle.difficulty = static_cast<uint8_t>(difficulty);
+    puzzle.symmetry = static_cast<uint8_t>(puzzleSymmetry);
+    for (int cell = 0; cell < CELL_COUNT; cell++) {
+        int num = cells[cell] & VALUE_MASK;
+        puzzle.setCell(cell, num);
+        if (num != 0) puzzle.clues++;
+    }
+    return puzzle;
+}
+
+template <int Box>
+bool BasicSudoku<Box>::solve() {
+    SUDOKU_STAT_CAPTURE(stats);
+    SUDOKU_STAT_TIMER(solveMicros);
+    Grid grid = getDigits();
+    if (getSolver<Box>(solverEngine).solve(grid) == 0) {
+        return false;
+    }
+    fillEmptyCells(grid);
+    return true;
+}
+
+template <int Box>
+bool BasicSudoku<Box>::isValid(int row, int col, int num) const {
+    return (usedDigits(cellIndex(row, col)) & digitBit(num)) == 0;
+}
+
+template <int Box>
+typename BasicSudoku<Box>::Mask BasicSudoku<Box>::getCandidates(int row, int col) const {
+    return static_cast<Mask>(~usedDigits(cellIndex(row, col)) & Tables::ALL_DIGITS);
+}
 
-    removeCells(cellsToRemove);
+template <int Box>
+int BasicSudoku<Box>::countCandidates(int row, int col) const {
+    return __builtin_popcountll(getCandidates(row, col));
 }
 
-bool Sudoku::isValid(int row, int col, int num) const {
-    return isValidInRow(row, num) && 
-           isValidInCol(col, num) && 
-           isValidInBox(row - row % SUBGRID_SIZE, col - col % SUBGRID_SIZE, num);
+template <int Box>
+int BasicSudoku<Box>::countSolutions(int limit) const {
+    SUDOKU_STAT_TIMER(solveMicros);
+    Grid grid = getDigits();
+    return getSolver<Box>(solverEngine).solve(grid, limit);
 }
 
-bool Sudoku::isCellEditable(int row, int col) const {
-    return !fixed[row][col];
+template <int Box>
+bool BasicSudoku<Box>::isCellEditable(int row, int col) const {
+    return (cells[cellIndex(row, col)] & FIXED_FLAG) == 0;
 }
 
-bool Sudoku::setNumber(int row, int col, int num) {
+template <int Box>
+bool BasicSudoku<Box>::setNumber(int row, int col, int num) {
     if(!isCellEditable(row, col)) {
         return false;
     }
     
-    // Allow any number (0-9) to be entered
-    if (num >= 0 && num <= 9) {
-        grid[row][col] = num;
+    // Allow any number (0-N) to be entered
+    if (num >= 0 && num <= GRID_SIZE) {
+        int cell = cellIndex(row, col);
+        if (cells[cell] != 0) {
+            clearDigit(cell);
+        }
+        if (num != 0) {
+            placeDigit(cell, num);
+        }
         return true;
     }
     
     return false;
 }
 
-int Sudoku::getNumber(int row, int col) const {
-    return grid[row][col];
+template <int Box>
+bool BasicSudoku<Box>::setNotes(int row, int col, Mask digits) {
+    if (!isCellEditable(row, col)) {
+        return false;
+    }
+    int cell = cellIndex(row, col);
+    digits &= Tables::ALL_DIGITS;
+    if (notes[cell] != digits) {
+        notes[cell] = digits;
+        markDirty(cell);
+    }
+    return true;
 }
 
-bool Sudoku::isSolved() const {
-    // Check if all cells are filled
-    for (int i = 0; i < GRID_SIZE; i++) {
-        for (int j = 0; j < GRID_SIZE; j++) {
-            if (grid[i][j] == 0) {
-                return false;
-            }
-        }
+template <int Box>
+bool BasicSudoku<Box>::toggleNote(int row, int col, int num) {
+    if (num < 1 || num > GRID_SIZE || getNumber(row, col) != 0) {
+        return false;
     }
+    return setNotes(row, col, notes[cellIndex(row, col)] ^ digitBit(num));
+}
 
-    // Check each row
-    for (int row = 0; row < GRID_SIZE; row++) {
-        std::vector<bool> seen(GRID_SIZE + 1, false);
-        for (int col = 0; col < GRID_SIZE; col++) {
-            int num = grid[row][col];
-            if (seen[num]) return false;
-            seen[num] = true;
+template <int Box>
+uint64_t BasicSudoku<Box>::clearPeerNotes(int row, int col, int num) {
+    static_assert(Tables::PEER_COUNT <= 64, "peer bits must fit one word");
+    const auto& peers = tables().peers[cellIndex(row, col)];
+    Mask bit = digitBit(num);
+    uint64_t cleared = 0;
+    for (int i = 0; i < Tables::PEER_COUNT; i++) {
+        if (notes[peers[i]] & bit) {
+            notes[peers[i]] &= ~bit;
+            markDirty(peers[i]);
+            cleared |= uint64_t(1) << i;
         }
     }
+    return cleared;
+}
 
-    // Check each column
-    for (int col = 0; col < GRID_SIZE; col++) {
-        std::vector<bool> seen(GRID_SIZE + 1, false);
-        for (int row = 0; row < GRID_SIZE; row++) {
-            int num = grid[row][col];
-            if (seen[num]) return false;
-            seen[num] = true;
-        }
+template <int Box>
+void BasicSudoku<Box>::restorePeerNotes(int row, int col, int num, uint64_t peerBits) {
+    const auto& peers = tables().peers[cellIndex(row, col)];
+    while (peerBits) {
+        int i = __builtin_ctzll(peerBits);
+        peerBits &= peerBits - 1;
+        notes[peers[i]] |= digitBit(num);
+        markDirty(peers[i]);
     }
+}
 
-    // Check each 3x3 box
-    for (int box = 0; box < 9; ++box) {
-        bool seen[10] = {false};
-        int startRow = (box / 3) * 3;
-        int startCol = (box % 3) * 3;
-        for (int i = 0; i < 9; ++i) {
-            int row = startRow + i / 3;
-            int col = startCol + i % 3;
-            int num = grid[row][col];
-            if (num == 0) continue;
-            if (seen[num]) return false;
-            seen[num] = true;
+template <int Box>
+void BasicSudoku<Box>::fillNotes() {
+    for (int cell = 0; cell < CELL_COUNT; cell++) {
+        Mask digits = cells[cell] == 0 ? static_cast<Mask>(~usedDigits(cell) & Tables::ALL_DIGITS) : 0;
+        if (notes[cell] != digits) {
+            notes[cell] = digits;
+            markDirty(cell);
         }
     }
-    return true;
 }
 
-bool Sudoku::solveGrid() {
-    int row, col;
-    if (!findEmptyCell(row, col)) {
-        return true; // Solved
-    }
-
-    std::vector<int> nums(GRID_SIZE);
-    std::iota(nums.begin(), nums.end(), 1);
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::shuffle(nums.begin(), nums.end(), gen);
-
-    for (int num : nums) {
-        if (isValid(row, col, num)) {
-            grid[row][col] = num;
-
-            if (solveGrid()) {
-                return true;
-            }
+template <int Box>
+int BasicSudoku<Box>::getNumber(int row, int col) const {
+    return cells[cellIndex(row, col)] & VALUE_MASK;
+}
 
-            grid[row][col] = 0; // Backtrack
+template <int Box>
+std::string BasicSudoku<Box>::toString() const {
+    std::string text(CELL_COUNT, '.');
+    for (int cell = 0; cell < CELL_COUNT; cell++) {
+        int num = cells[cell] & VALUE_MASK;
+        if (num != 0) {
+            text[cell] = digitSymbol(num);
         }
     }
-    return false;
+    return text;
 }
 
-void Sudoku::removeCells(int cellsToRemove) {
-    while (cellsToRemove > 0) {
-        int row = std::rand() % GRID_SIZE;
-        int col = std::rand() % GRID_SIZE;
+template <int Box>
+bool BasicSudoku<Box>::solveGrid(Rng& rng) {
+    Grid grid = getDigits();
 
-        if (grid[row][col] != 0) {
-            grid[row][col] = 0;
-            fixed[row][col] = false;
-            cellsToRemove--;
-        }
+    // The backtracker shuffles its value order so completions stay varied. It is
+    // used whatever the selected engine, so a seed means the same grid everywhere.
+    BasicBacktrackingSolver<Box> shuffled(&rng);
+    if (shuffled.solve(grid) == 0) {
+        return false;
     }
+    fillEmptyCells(grid);
+    return true;
 }
 
-bool Sudoku::findEmptyCell(int &row, int &col) const {
-    for (row = 0; row < GRID_SIZE; row++) {
-        for (col = 0; col < GRID_SIZE; col++) {
-            if (grid[row][col] == 0) {
-                return true;
-            }
+template <int Box>
+void BasicSudoku<Box>::fillEmptyCells(const Grid& solution) {
+    for (int cell = 0; cell < CELL_COUNT; cell++) {
+        if (cells[cell] == 0) {
+            placeDigit(cell, solution[cell]);
         }
     }
-    return false;
 }
 
-bool Sudoku::isValidInRow(int row, int num) const {
-    for (int col = 0; col < GRID_SIZE; col++) {
-        if (grid[row][col] == num) {
-            return false;
+template <int Box>
+int BasicSudoku<Box>::removeCells(int cellsToRemove, Rng& rng) {
+    SUDOKU_STAT_TIMER(removeMicros);
+    std::array<int, CELL_COUNT> order;
+    std::iota(order.begin(), order.end(), 0);
+    rng.shuffle(order.begin(), order.end());
+
+    // Each check starts from the candidate board the previous removal left behind
+    // and only asks whether an emptied cell could take another digit. Proving that
+    // for a sparse 16x16 or 25x25 can still take a very long search; past the
+    // budget the clues simply stay, which keeps the puzzle unique
+    BasicBacktrackingSolver<Box> checker;
+    if (Box > 3) checker.setNodeLimit(UNIQUENESS_NODE_LIMIT);
+    checker.beginRemoval(getDigits());
+
+    // Visit every cell once in random order, together with its symmetric partner,
+    // and keep a removal only while the puzzle still has exactly one solution; a
+    // dense board runs out of removable cells before a sparse target, so stop there
+    std::array<bool, CELL_COUNT> visited{};
+    int removed = 0;
+    for (int i = 0; i < CELL_COUNT && removed < cellsToRemove; i++) {
+        int group[2];
+        int size = symmetricGroup(order[i], group);
+        if (visited[group[0]] || removed + size > cellsToRemove) continue;
+        for (int k = 0; k < size; k++) visited[group[k]] = true;
+
+        SUDOKU_STAT(uniquenessChecks, 1);
+        if (checker.tryRemove(group, size)) {
+            for (int k = 0; k < size; k++) clearDigit(group[k]);   // also drops the fixed flag
+            removed += size;
+        } else {
+            SUDOKU_STAT(cellsRestored, size);
         }
     }
-    return true;
+    return removed;
 }
 
-bool Sudoku::isValidInCol(int col, int num) const {
-    for (int row = 0; row < GRID_SIZE; row++) {
-        if (grid[row][col] == num) {
-            return false;
-        }
+template <int Box>
+int BasicSudoku<Box>::symmetricGroup(int cell, int* group) const {
+    int row = tables().rowOf[cell];
+    int col = tables().colOf[cell];
+    int partner = cell;
+    if (symmetry == Symmetry::Rotational) {
+        partner = CELL_COUNT - 1 - cell;
+    } else if (symmetry == Symmetry::Mirror) {
+        partner = cellIndex(row, GRID_SIZE - 1 - col);
     }
-    return true;
+    group[0] = cell;
+    group[1] = partner;
+    return partner == cell ? 1 : 2;
 }
 
-bool Sudoku::isValidInBox(int startRow, int startCol, int num) const {
-    for (int i = 0; i < SUBGRID_SIZE; i++) {
-        for (int j = 0; j < SUBGRID_SIZE; j++) {
-            if (grid[i + startRow][j + startCol] == num) {
-                return false;
-            }
-        }
+template <int Box>
+bool BasicSudoku<Box>::findEmptyCell(int &row, int &col) const {
+    auto it = std::find(cells.begin(), cells.end(), 0);
+    if (it == cells.end()) {
+        return false;
     }
+    int cell = static_cast<int>(it - cells.begin());
+    row = tables().rowOf[cell];
+    col = tables().colOf[cell];
     return true;
 }
 
-bool Sudoku::hasConflict(int row, int col) const {
-    if (row < 0 || col < 0 || row >= GRID_SIZE || col >= GRID_SIZE || grid[row][col] == 0) {
-        return false;
+template <int Box>
+typename BasicSudoku<Box>::Grid BasicSudoku<Box>::getDigits() const {
+    Grid grid;
+    for (int cell = 0; cell < CELL_COUNT; cell++) {
+        grid[cell] = cells[cell] & VALUE_MASK;
     }
+    return grid;
+}
 
-    int num = grid[row][col];
-    int count = 0;
+template <int Box>
+typename BasicSudoku<Box>::Mask BasicSudoku<Box>::usedDigits(int cell) const {
+    return rowMask[tables().rowOf[cell]] | colMask[tables().colOf[cell]] | boxMask[tables().boxOf[cell]];
+}
 
-    // Check row
-    for (int c = 0; c < GRID_SIZE; c++) {
-        if (grid[row][c] == num) count++;
+template <int Box>
+void BasicSudoku<Box>::placeDigit(int cell, int num) {
+    cells[cell] = static_cast<uint8_t>(num);
+    filledCount++;
+    digitTotal[num]++;
+    markDirty(cell);
+    Mask bit = digitBit(num);
+    rowMask[tables().rowOf[cell]] |= bit;
+    colMask[tables().colOf[cell]] |= bit;
+    boxMask[tables().boxOf[cell]] |= bit;
+
+    // User input may repeat a digit; the masks only say "present", the counts say how often
+    int row = ++digitCount[tables().rowOf[cell]][num];
+    int col = ++digitCount[GRID_SIZE + tables().colOf[cell]][num];
+    int box = ++digitCount[2 * GRID_SIZE + tables().boxOf[cell]][num];
+    if (row == 2 || col == 2 || box == 2) {
+        refreshConflicts(cell, num);    // the first repeat in a unit also flags the cell already there
+    } else if (row > 2 || col > 2 || box > 2) {
+        refreshConflict(cell);
     }
-    if (count > 1) return true;
+}
 
-    // Check column
-    count = 0;
-    for (int r = 0; r < GRID_SIZE; r++) {
-        if (grid[r][col] == num) count++;
+template <int Box>
+void BasicSudoku<Box>::clearDigit(int cell) {
+    int num = cells[cell] & VALUE_MASK;
+    cells[cell] = 0;
+    filledCount--;
+    digitTotal[num]--;
+    markDirty(cell);
+
+    int row = --digitCount[tables().rowOf[cell]][num];
+    int col = --digitCount[GRID_SIZE + tables().colOf[cell]][num];
+    int box = --digitCount[2 * GRID_SIZE + tables().boxOf[cell]][num];
+    Mask bit = digitBit(num);
+    if (row == 0) rowMask[tables().rowOf[cell]] &= ~bit;
+    if (col == 0) colMask[tables().colOf[cell]] &= ~bit;
+    if (box == 0) boxMask[tables().boxOf[cell]] &= ~bit;
+
+    if (row == 1 || col == 1 || box == 1) {
+        refreshConflicts(cell, num);    // a peer may have lost its only clash
+    } else {
+        refreshConflict(cell);
     }
-    if (count > 1) return true;
+}
 
-    // Check box
-    count = 0;
-    int boxStartRow = row - (row % SUBGRID_SIZE);
-    int boxStartCol = col - (col % SUBGRID_SIZE);
-    for (int r = 0; r < SUBGRID_SIZE; r++) {
-        for (int c = 0; c < SUBGRID_SIZE; c++) {
-            if (grid[boxStartRow + r][boxStartCol + c] == num) count++;
+template <int Box>
+void BasicSudoku<Box>::refreshConflict(int cell) {
+    int num = cells[cell] & VALUE_MASK;
+    bool clash = num != 0 && (digitCount[tables().rowOf[cell]][num] > 1 ||
+                              digitCount[GRID_SIZE + tables().colOf[cell]][num] > 1 ||
+                              digitCount[2 * GRID_SIZE + tables().boxOf[cell]][num] > 1);
+    uint64_t bit = uint64_t(1) << (cell % 64);
+    uint64_t& word = conflictBits[cell / 64];
+    if (clash != ((word & bit) != 0)) {
+        word ^= bit;
+        conflictCount += clash ? 1 : -1;
+        markDirty(cell);
+    }
+}
+
+template <int Box>
+void BasicSudoku<Box>::refreshConflicts(int cell, int num) {
+    refreshConflict(cell);
+    for (auto peer : tables().peers[cell]) {
+        if ((cells[peer] & VALUE_MASK) == num) {
+            refreshConflict(peer);
         }
     }
-    return count > 1;
 }
 
+template <int Box>
+bool BasicSudoku<Box>::hasConflict(int row, int col) const {
+    if (row < 0 || col < 0 || row >= GRID_SIZE || col >= GRID_SIZE) {
+        return false;
+    }
+    int cell = cellIndex(row, col);
+    return (conflictBits[cell / 64] >> (cell % 64)) & 1;
+}
+
+template <int Box>
+bool BasicSudoku<Box>::isDirty(int row, int col) const {
+    int cell = cellIndex(row, col);
+    return (dirtyBits[cell / 64] >> (cell % 64)) & 1;
+}
 
+template class BasicSudoku<3>;
+template class BasicSudoku<4>;
+template class BasicSudoku<5>;
 
+template void BasicSudoku<3>::loadPacked<3, void>(const PackedPuzzle& puzzle);
+template PackedPuzzle BasicSudoku<3>::pack<3, void>(int difficulty) const;
@@ -1,9 +1,12 @@
 #include "game.h"
+#include <cstring>
+#include <cstdlib>
 #include <iostream>
 
-int main(int, char**) {
-    Game game;
-    
+template <int Box>
+int play() {
+    BasicGame<Box> game;
+
     if (!game.init()) {
         std::cerr << "Failed to initialize game!" << std::endl;
         return 1;
@@ -11,4 +14,21 @@ int main(int, char**) {
 
     game.run();
     return 0;
-}
\ No newline at end of file
+}
+
+int main(int argc, char** argv) {
+    // Board size: 9 (default), 16 or 25
+    int size = 9;
+    if (argc >= 3 && (std::strcmp(argv[1], "-s") == 0 || std::strcmp(argv[1], "--size") == 0)) {
+        size = std::atoi(argv[2]);
+    }
+
+    switch (size) {
+        case 9:  return play<3>();
+        case 16: return play<4>();
+        case 25: return play<5>();
+        default:
+            std::cerr << "usage: sudoku [-s 9|16|25]" << std::endl;
+            return 1;
+    }
+}
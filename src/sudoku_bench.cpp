@@ -0,0 +1,263 @@
+// Benchmarks for the Sudoku core (no SDL): generation per difficulty, solving fixed
+// corpora with each engine, and the per-cell queries the game calls every frame.
+// Prints min/median/p99 per operation and ops/sec; --json writes the same for comparing runs.
+#include "sudoku.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Corpora are fixed strings so runs stay comparable whatever the generator does later
+const char* const EASY_CORPUS[] = {
+    "..8..1..32...67.95...8.5.1..42..378.3976.4.21.....26.41...3..5.483..9.6792..1..48",
+    ".5..6..2131.527.94..93..7...7.8.6....4..3516.6..1425.9..497.61..6..549......81..2",
+    "6.....7.2..562.19.281.73.4647936.21.1.6..587..5.2..9....714.359.4.7.9..19...5.427",
+    "5894..6.1..219....7.463..59.28.4.....57..9.8.9.15..7.41.3.549.22.691....8952.7...",
+    "2..9..6315....1..79.176.54..45.....9...517....7649.1.3.12.45.964.8..6.15..31.9.74",
+    "71..4..2..937526..28......5...1.9.366..52........63.5...7.3..91..2.148...6927.54.",
+    ".9.1..3...318.4.9.2.7.39..54...8.9577.95......53..7.123859.27....4.5.8.9.6..18.4.",
+    "1347...8.....4.537..528......7....4.5..432...4.39..26531.8.54769.86.7.537.631..2.",
+    "2...3....5.9.81.76...4.9213926..48...53.2.69.78..95321..29781.5.175..9.2.9..4.7.8",
+    "1.....396.9..13..5...72..8...6.71.43..12.....789.64.1..1..3.6..2.79.6..4..4.52.38",
+};
+
+// From Gordon Royle's collection of 17-clue puzzles; the first is notoriously slow for plain backtracking
+const char* const CLUE17_CORPUS[] = {
+    "..............3.85..1.2.......5.7.....4...1...9.......5......73..2.1........4...9",
+    "000000010400000000020000000000050407008000300001090000300400200050100000000806000",
+    "000000010400000000020000000000050604008000300001090000300400200050100000000807000",
+    "000000012000035000000600070700000300000400800100000000000120000080000040050000600",
+    "000000012003600000000007000410020000000500300700000600280000040000300500000000000",
+    "000000012008030000000000040120500000000004700060000000507000300000620000000100000",
+    "000000012040050000000009000070600400000100000000000050000087500601000300200000000",
+    "000000012050400000000000030700600400001000000000080000920000800000510700000003000",
+    "000000013000030080070000000000206000030000900000010000600500204000400700100000000",
+    "000000013000200000000000080000760200008000400010000000200000750600340000000008000",
+};
+
+// Published "hardest" puzzles, then ones our grader could not finish without guessing
+const char* const HARD_CORPUS[] = {
+    "1....7.9..3..2...8..96..5....53..9...1..8...26....4...3......1..4......7..7...3..",   // AI Escargot
+    "1.......2.9.4...5...6...7...5.9.3.......7.......85..4.7.....6...3...9.8...2.....1",   // Easter Monster
+    "8..........36......7..9.2...5...7.......457.....1...3...1....68..85...1..9....4..",   // Inkala 2012
+    ".2.4.37.........32........4.4.2...7.8...5.........1...5.....9...3.9....7..1..86..",
+    "...8...5..3.....192...69...4.5....2........648..5..9...74.....3...2...9.....9.145",
+    "..7..3.1......7..4...19..26.....5.....27...3.5...2.69.......56.61.3...8..25......",
+    "6....35..7..2...9..3..4........6.94..519..3..........8..9..41..34.8....2..2......",
+    "..17....9.3........723....1..5.....43....7.1.26..9.8..1..4.93..........5..6..8.4.",
+};
+
+const int GENERATE_SAMPLES = 100;     // per difficulty, seeds 1..n
+const int SOLVE_SAMPLES = 1000;       // per corpus and engine, cycling through the corpus
+const int QUERY_SAMPLES = 2000;
+const int QUERY_BATCH = 1024;         // calls per query sample; too fast to time one by one
+
+struct Options {
+    const char* filter = nullptr;     // only benchmarks whose name contains this
+    const char* json = nullptr;       // "-" = stdout
+    int scale = 1;                    // -q divides the sample counts by 10
+};
+
+struct Result {
+    std::string name;
+    size_t samples = 0;
+    double minNs = 0;
+    double medianNs = 0;
+    double p99Ns = 0;
+    double opsPerSec = 0;
+};
+
+void printUsage() {
+    std::cerr << "usage: sudoku-bench [-q] [--filter name] [--json file]\n"
+              << "  -q  a tenth of the samples, for a quick look\n"
+              << "  --filter  run only the benchmarks whose name contains this text\n"
+              << "  --json  also write the results as JSON ('-' for stdout)\n";
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "-q") == 0) {
+            options.scale = 10;
+        } else if (std::strcmp(argv[i], "--filter") == 0 && hasValue) {
+            options.filter = argv[++i];
+        } else if (std::strcmp(argv[i], "--json") == 0 && hasValue) {
+            options.json = argv[++i];
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Times `samples` runs of `op`, each doing `opsPerSample` operations, and reports per operation.
+// `prepare` runs untimed before each sample.
+Result measure(const std::string& name, int samples, int opsPerSample,
+               const std::function<void(int)>& prepare, const std::function<void(int)>& op) {
+    using Clock = std::chrono::steady_clock;
+    std::vector<double> times;
+    times.reserve(samples);
+    double total = 0;
+    for (int i = 0; i < samples; i++) {
+        prepare(i);
+        auto start = Clock::now();
+        op(i);
+        double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        times.push_back(ns / opsPerSample);
+        total += ns;
+    }
+    std::sort(times.begin(), times.end());
+
+    Result result;
+    result.name = name;
+    result.samples = times.size();
+    result.minNs = times.front();
+    result.medianNs = times[times.size() / 2];
+    result.p99Ns = times[std::min(times.size() - 1, times.size() * 99 / 100)];
+    result.opsPerSec = total > 0 ? 1e9 * samples * opsPerSample / total : 0;
+    return result;
+}
+
+std::vector<Sudoku> loadCorpus(const char* const* puzzles, size_t count) {
+    std::vector<Sudoku> boards(count, Sudoku(EmptyBoard()));
+    for (size_t i = 0; i < count; i++) {
+        if (!boards[i].loadPuzzle(puzzles[i])) {
+            std::cerr << "Bad corpus puzzle: " << puzzles[i] << std::endl;
+        }
+    }
+    return boards;
+}
+
+std::string formatNs(double ns) {
+    char text[32];
+    if (ns >= 1e6) {
+        std::snprintf(text, sizeof(text), "%.2f ms", ns / 1e6);
+    } else if (ns >= 1e3) {
+        std::snprintf(text, sizeof(text), "%.2f us", ns / 1e3);
+    } else {
+        std::snprintf(text, sizeof(text), "%.1f ns", ns);
+    }
+    return text;
+}
+
+void writeJson(FILE* out, const std::vector<Result>& results) {
+    std::fprintf(out, "{\n  \"compiler\": \"%s\",\n  \"hardware_threads\": %u,\n  \"benchmarks\": [\n",
+                 __VERSION__, std::thread::hardware_concurrency());
+    for (size_t i = 0; i < results.size(); i++) {
+        const Result& r = results[i];
+        std::fprintf(out, "    {\"name\": \"%s\", \"samples\": %zu, \"min_ns\": %.1f, \"median_ns\": %.1f, "
+                          "\"p99_ns\": %.1f, \"ops_per_sec\": %.1f}%s\n",
+                     r.name.c_str(), r.samples, r.minNs, r.medianNs, r.p99Ns, r.opsPerSec,
+                     i + 1 < results.size() ? "," : "");
+    }
+    std::fprintf(out, "  ]\n}\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+
+    // With --json - the JSON owns stdout and the table moves to stderr
+    bool jsonToStdout = options.json && std::strcmp(options.json, "-") == 0;
+    FILE* table = jsonToStdout ? stderr : stdout;
+
+    std::vector<Result> results;
+    auto wanted = [&options](const std::string& name) {
+        return !options.filter || name.find(options.filter) != std::string::npos;
+    };
+    auto report = [&results, table](const Result& r) {
+        std::fprintf(table, "%-26s %7zu %12s %12s %12s %14.1f\n", r.name.c_str(), r.samples,
+                    formatNs(r.minNs).c_str(), formatNs(r.medianNs).c_str(), formatNs(r.p99Ns).c_str(), r.opsPerSec);
+        std::fflush(table);
+        results.push_back(r);
+    };
+    auto none = [](int) {};
+    std::fprintf(table, "%-26s %7s %12s %12s %12s %14s\n", "benchmark", "samples", "min", "median", "p99", "ops/sec");
+
+    // Generation: fixed seeds, so every run builds the same puzzles
+    static const char* const LEVEL_NAMES[] = {"easy", "medium", "hard"};
+    for (int level = 1; level <= 3; level++) {
+        std::string name = std::string("generate/") + LEVEL_NAMES[level - 1];
+        if (!wanted(name)) continue;
+        Sudoku sudoku{EmptyBoard()};
+        report(measure(name, GENERATE_SAMPLES / options.scale, 1, none,
+                       [&sudoku, level](int i) { sudoku.generatePuzzle(level, static_cast<uint64_t>(i) + 1); }));
+    }
+
+    // Solving: a fresh copy of the puzzle per sample, copied outside the timed region
+    struct Corpus {
+        const char* name;
+        std::vector<Sudoku> boards;
+    };
+    Corpus corpora[] = {
+        {"easy", loadCorpus(EASY_CORPUS, sizeof(EASY_CORPUS) / sizeof(EASY_CORPUS[0]))},
+        {"17-clue", loadCorpus(CLUE17_CORPUS, sizeof(CLUE17_CORPUS) / sizeof(CLUE17_CORPUS[0]))},
+        {"hard", loadCorpus(HARD_CORPUS, sizeof(HARD_CORPUS) / sizeof(HARD_CORPUS[0]))},
+    };
+    const std::pair<SolverEngine, const char*> engines[] = {
+        {SolverEngine::Backtracking, "backtracking"},
+        {SolverEngine::DancingLinks, "dlx"},
+        {SolverEngine::Parallel, "parallel"},
+    };
+    for (const Corpus& corpus : corpora) {
+        for (const auto& engine : engines) {
+            std::string name = std::string("solve/") + corpus.name + "/" + engine.second;
+            if (!wanted(name)) continue;
+            Sudoku board{EmptyBoard()};
+            SolverEngine selected = engine.first;
+            report(measure(name, SOLVE_SAMPLES / options.scale, 1,
+                           [&board, &corpus, selected](int i) {
+                               board = corpus.boards[i % corpus.boards.size()];
+                               board.setSolverEngine(selected);
+                           },
+                           [&board](int) { board.solve(); }));
+        }
+    }
+
+    // Per-cell queries on a half-filled board with a few clashing user digits
+    Sudoku board{EmptyBoard()};
+    board.generatePuzzle(2, 1);
+    for (int cell = 0; cell < Sudoku::CELL_COUNT; cell += 7) {
+        int row = cell / Sudoku::GRID_SIZE;
+        int col = cell % Sudoku::GRID_SIZE;
+        if (board.isCellEditable(row, col)) board.setNumber(row, col, 1 + cell % Sudoku::GRID_SIZE);
+    }
+    volatile int sink = 0;
+    auto query = [&](const char* name, const std::function<int(int, int)>& call) {
+        if (!wanted(name)) return;
+        report(measure(name, QUERY_SAMPLES / options.scale, QUERY_BATCH, none, [&](int) {
+            int hits = 0;
+            for (int i = 0; i < QUERY_BATCH; i++) {
+                int cell = i % Sudoku::CELL_COUNT;
+                hits += call(cell / Sudoku::GRID_SIZE, cell % Sudoku::GRID_SIZE);
+            }
+            sink = sink + hits;
+        }));
+    };
+    query("query/isSolved", [&board](int, int) { return board.isSolved() ? 1 : 0; });
+    query("query/hasConflict", [&board](int row, int col) { return board.hasConflict(row, col) ? 1 : 0; });
+    query("query/isValid", [&board](int row, int col) { return board.isValid(row, col, 1 + (row + col) % 9) ? 1 : 0; });
+
+    if (options.json) {
+        FILE* out = jsonToStdout ? stdout : std::fopen(options.json, "w");
+        if (!out) {
+            std::cerr << "Cannot write " << options.json << std::endl;
+            return 1;
+        }
+        writeJson(out, results);
+        if (out != stdout) std::fclose(out);
+    }
+    return 0;
+}
@@ -0,0 +1,307 @@
+// Headless batch puzzle generator: writes one 81-character puzzle per line
+#include "sudoku.h"
+#include "canonical.h"
+#include "puzzle_db.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const long FLUSH_EVERY = 256;  // puzzles per chunk, the unit of work and of output
+
+struct Options {
+    long count = 1000;         // puzzles per difficulty
+    int difficulty = 0;        // 0 = all three levels
+    int threads = 0;           // 0 = all cores
+    const char* output = nullptr;
+    const char* database = nullptr;
+    bool scaling = false;
+    bool seeded = false;
+    uint64_t seed = 0;         // --seed: makes the whole run reproducible
+    bool ids = false;          // append each puzzle's ID to its line
+    const char* rebuild = nullptr;   // --id: print just this puzzle
+    Symmetry symmetry = Symmetry::None;
+    bool dedup = false;        // drop puzzles isomorphic to one already written
+};
+
+void printUsage() {
+    std::cerr << "usage: sudoku-gen [-n count] [-d 1|2|3] [-t threads] [-o file | --db file] [--seed n] [--ids]\n"
+              << "                  [--symmetry none|rotational|mirror] [--dedup] [--scaling]\n"
+              << "       sudoku-gen --id puzzle-id\n"
+              << "  -n  puzzles per difficulty (default 1000)\n"
+              << "  -d  only this difficulty (default: all)\n"
+              << "  -t  worker threads (default: all cores)\n"
+              << "  -o  write puzzles to file instead of stdout\n"
+              << "  --db  write a packed puzzle bank (see puzzle_db.h) instead of text\n"
+              << "  --seed  derive every puzzle from this seed, so the same run gives the same puzzles\n"
+              << "  --ids  append each puzzle's ID after it\n"
+              << "  --symmetry  keep the clues symmetric under a half turn or a left-right mirror\n"
+              << "  --dedup  skip puzzles that are a relabeling, reflection or row/column shuffle of an earlier one\n"
+              << "  --id  rebuild the puzzle with this ID (as shown in the game's title bar)\n"
+              << "  --scaling  time 1..N threads and report speedup, no puzzle output\n";
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "-n") == 0 && hasValue) {
+            options.count = std::atol(argv[++i]);
+        } else if (std::strcmp(argv[i], "-d") == 0 && hasValue) {
+            options.difficulty = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "-t") == 0 && hasValue) {
+            options.threads = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "-o") == 0 && hasValue) {
+            options.output = argv[++i];
+        } else if (std::strcmp(argv[i], "--db") == 0 && hasValue) {
+            options.database = argv[++i];
+        } else if (std::strcmp(argv[i], "--scaling") == 0) {
+            options.scaling = true;
+        } else if (std::strcmp(argv[i], "--seed") == 0 && hasValue) {
+            options.seeded = true;
+            options.seed = std::strtoull(argv[++i], nullptr, 0);
+        } else if (std::strcmp(argv[i], "--ids") == 0) {
+            options.ids = true;
+        } else if (std::strcmp(argv[i], "--dedup") == 0) {
+            options.dedup = true;
+        } else if (std::strcmp(argv[i], "--id") == 0 && hasValue) {
+            options.rebuild = argv[++i];
+        } else if (std::strcmp(argv[i], "--symmetry") == 0 && hasValue) {
+            const char* name = argv[++i];
+            if (std::strcmp(name, "none") == 0) {
+                options.symmetry = Symmetry::None;
+            } else if (std::strcmp(name, "rotational") == 0) {
+                options.symmetry = Symmetry::Rotational;
+            } else if (std::strcmp(name, "mirror") == 0) {
+                options.symmetry = Symmetry::Mirror;
+            } else {
+                return false;
+            }
+        } else {
+            return false;
+        }
+    }
+    return options.count > 0 && options.difficulty >= 0 && options.difficulty <= 3 && options.threads >= 0;
+}
+
+// Seed of the i-th puzzle of a seeded run; independent of thread count and scheduling
+uint64_t puzzleSeed(uint64_t runSeed, long i) {
+    uint64_t state = runSeed * 0x9E3779B97F4A7C15ull + static_cast<uint64_t>(i);
+    uint64_t seed = Rng::splitmix64(state);
+    return seed != 0 ? seed : 1;
+}
+
+// Generates `count` puzzles of each requested level on `threadCount` threads.
+// Every thread owns its Sudoku (and with it the generator's RNG) and works
+// through chunks of FLUSH_EVERY consecutive puzzles. Finished chunks are written
+// strictly in index order, with --dedup decided at that point too, so a seeded
+// run gives the same output whatever the thread count. A worker waits before
+// starting a chunk more than 2 x threadCount past the next one to write, so one
+// slow chunk cannot pile up the rest and memory stays flat however many are asked for.
+// With a bank writer the packed records are collected there instead.
+double generate(const Options& options, int threadCount, FILE* out, PuzzleDbWriter* bank) {
+    std::vector<int> levels;
+    for (int level = 1; level <= 3; level++) {
+        if (options.difficulty == 0 || options.difficulty == level) levels.push_back(level);
+    }
+    const long total = options.count * static_cast<long>(levels.size());
+    const long chunkCount = (total + FLUSH_EVERY - 1) / FLUSH_EVERY;
+
+    struct Chunk {
+        long size = 0;
+        std::string text;
+        std::vector<size_t> lineEnds;       // end of each puzzle's line in `text`
+        std::vector<PackedPuzzle> packed;
+        std::vector<uint64_t> hashes;       // canonical hashes, with --dedup
+    };
+
+    std::atomic<long> nextChunk(0);
+    std::mutex outputMutex;
+    std::condition_variable written;        // nextToWrite moved on
+    std::map<long, Chunk> finished;         // chunks waiting for an earlier one
+    long nextToWrite = 0;
+    const long maxAhead = 2 * static_cast<long>(threadCount);
+
+    // Canonical hashes of everything written so far; the canonical form is
+    // computed by the workers, only the O(1) index lookup runs under the lock
+    CanonicalIndex seen(options.dedup ? static_cast<size_t>(total) : 0);
+    long duplicates = 0;
+#ifdef SUDOKU_STATS
+    SolverStats allStats;
+#endif
+    auto start = std::chrono::steady_clock::now();
+
+    // Called with outputMutex held
+    auto write = [&](const Chunk& chunk) {
+        size_t lineStart = 0;
+        for (long k = 0; k < chunk.size; k++) {
+            if (options.dedup && !seen.insert(chunk.hashes[k])) {
+                duplicates++;
+            } else if (bank) {
+                bank->add(chunk.packed[k]);
+            } else if (out) {
+                std::fwrite(chunk.text.data() + lineStart, 1, chunk.lineEnds[k] - lineStart, out);
+            }
+            if (out && !bank) lineStart = chunk.lineEnds[k];
+        }
+    };
+
+    auto worker = [&]() {
+        Sudoku sudoku{EmptyBoard()};
+        sudoku.setSymmetry(options.symmetry);
+#ifdef SUDOKU_STATS
+        SolverStats threadStats;
+#endif
+
+        for (long c = nextChunk.fetch_add(1); c < chunkCount; c = nextChunk.fetch_add(1)) {
+            // Chunks are claimed in order, so whoever holds nextToWrite never waits here
+            {
+                std::unique_lock<std::mutex> lock(outputMutex);
+                written.wait(lock, [&]() { return c < nextToWrite + maxAhead; });
+            }
+
+            Chunk chunk;
+            if (out) chunk.text.reserve(FLUSH_EVERY * (Sudoku::CELL_COUNT + 1));
+            long end = std::min(total, (c + 1) * FLUSH_EVERY);
+            for (long i = c * FLUSH_EVERY; i < end; i++) {
+                int level = levels[i / options.count];
+                if (options.seeded) {
+                    sudoku.generatePuzzle(level, puzzleSeed(options.seed, i));
+                } else {
+                    sudoku.generatePuzzle(level);
+                }
+#ifdef SUDOKU_STATS
+                threadStats += sudoku.getStats();
+#endif
+                if (options.dedup) {
+                    chunk.hashes.push_back(canonicalHash(sudoku.getDigits()));
+                }
+                if (bank) {
+                    chunk.packed.push_back(sudoku.pack(level));
+                } else if (out) {
+                    chunk.text += sudoku.toString();
+                    if (options.ids) {
+                        chunk.text += ' ';
+                        chunk.text += sudoku.getPuzzleId();
+                    }
+                    chunk.text += '\n';
+                    chunk.lineEnds.push_back(chunk.text.size());
+                }
+                chunk.size++;
+            }
+
+            // Park the chunk, then write out every chunk that is now next in line
+            std::lock_guard<std::mutex> lock(outputMutex);
+            finished.emplace(c, std::move(chunk));
+            long before = nextToWrite;
+            for (auto it = finished.find(nextToWrite); it != finished.end(); it = finished.find(nextToWrite)) {
+                write(it->second);
+                finished.erase(it);
+                nextToWrite++;
+            }
+            if (nextToWrite != before) written.notify_all();
+        }
+#ifdef SUDOKU_STATS
+        std::lock_guard<std::mutex> lock(outputMutex);
+        allStats += threadStats;
+#endif
+    };
+
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threadCount; t++) {
+        pool.emplace_back(worker);
+    }
+    for (auto& thread : pool) {
+        thread.join();
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (options.dedup) {
+        std::fprintf(stderr, "%ld isomorphic duplicates dropped\n", duplicates);
+    }
+#ifdef SUDOKU_STATS
+    if (total > 0) {
+        double n = static_cast<double>(total);
+        std::fprintf(stderr, "per puzzle: %.0f nodes, %.0f backtracks, %.0f propagations, %.1f uniqueness checks, "
+                             "%.1f cells restored; fill %.0f us, remove %.0f us\n",
+                     allStats.nodes / n, allStats.backtracks / n, allStats.propagations / n, allStats.uniquenessChecks / n,
+                     allStats.cellsRestored / n, allStats.fillMicros / n, allStats.removeMicros / n);
+    }
+#endif
+    return total / seconds;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+
+    if (options.rebuild) {
+        Sudoku sudoku{EmptyBoard()};
+        if (!sudoku.generateFromId(options.rebuild)) {
+            std::cerr << "Not a puzzle ID: " << options.rebuild << std::endl;
+            return 1;
+        }
+        std::printf("%s %s\n", sudoku.toString().c_str(), sudoku.getPuzzleId().c_str());
+        return 0;
+    }
+
+    int cores = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    int threads = options.threads > 0 ? options.threads : cores;
+
+    if (options.scaling) {
+        // 1, 2, 4, ... and finally the full thread count
+        std::vector<int> counts;
+        for (int t = 1; t < threads; t *= 2) counts.push_back(t);
+        counts.push_back(threads);
+
+        double single = 0.0;
+        for (int t : counts) {
+            double rate = generate(options, t, nullptr, nullptr);
+            if (t == 1) single = rate;
+            std::fprintf(stderr, "threads %2d: %10.1f puzzles/sec  speedup %.2fx\n", t, rate, rate / single);
+        }
+        return 0;
+    }
+
+    if (options.database) {
+        PuzzleDbWriter bank;
+        double rate = generate(options, threads, nullptr, &bank);
+        if (!bank.write(options.database)) {
+            std::cerr << "Failed to write " << options.database << std::endl;
+            return 1;
+        }
+        std::fprintf(stderr, "%d threads: %.1f puzzles/sec, %zu puzzles written to %s\n", threads, rate, bank.size(), options.database);
+        return 0;
+    }
+
+    FILE* out = stdout;
+    if (options.output) {
+        out = std::fopen(options.output, "w");
+        if (!out) {
+            std::cerr << "Failed to open " << options.output << " for writing" << std::endl;
+            return 1;
+        }
+    }
+
+    double rate = generate(options, threads, out, nullptr);
+    if (out != stdout) {
+        std::fclose(out);
+    }
+    std::fprintf(stderr, "%d threads: %.1f puzzles/sec\n", threads, rate);
+    return 0;
+}
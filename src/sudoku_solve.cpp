@@ -0,0 +1,333 @@
+// Streaming batch solver: reads 81-character puzzles ('.' or '0' for empty cells)
+// one per line and writes their solutions (or, with -g, their grades) in input order
+#include "sudoku.h"
+#include "batch_solver.h"
+#include "grader.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const size_t BATCH_SIZE = 4096;        // puzzles per batch
+const size_t MAX_IN_FLIGHT_PER_THREAD = 2;
+
+struct Options {
+    int threads = 0;                    // 0 = all cores
+    SolverEngine engine = SolverEngine::Backtracking;
+    bool vectorized = false;            // -e simd: BatchSolver lanes, backtracking for the rest
+    bool grade = false;                 // -g: rate by the techniques needed instead of solving
+    const char* input = nullptr;        // nullptr or "-" = stdin
+    const char* output = nullptr;
+};
+
+struct Batch {
+    std::vector<std::string> lines;     // puzzles in, solutions out (rewritten in place)
+    size_t solved = 0;
+    size_t unsolvable = 0;
+    size_t invalid = 0;
+    bool done = false;
+};
+
+void printUsage() {
+    std::cerr << "usage: sudoku-solve [-t threads] [-e backtracking|dlx|parallel|simd] [-g] [-o file] [file]\n"
+              << "  reads stdin when no file (or '-') is given\n"
+              << "  -e parallel splits each hard puzzle across all cores and ignores -t\n"
+              << "  -g writes '<puzzle> <score> <hardest technique>' instead of the solution\n"
+              << "  unreadable lines are answered with 'invalid', impossible ones with 'unsolvable'\n";
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "-t") == 0 && hasValue) {
+            options.threads = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "-e") == 0 && hasValue) {
+            const char* name = argv[++i];
+            if (std::strcmp(name, "dlx") == 0) {
+                options.engine = SolverEngine::DancingLinks;
+            } else if (std::strcmp(name, "backtracking") == 0) {
+                options.engine = SolverEngine::Backtracking;
+            } else if (std::strcmp(name, "parallel") == 0) {
+                options.engine = SolverEngine::Parallel;
+            } else if (std::strcmp(name, "simd") == 0) {
+                options.vectorized = true;
+            } else {
+                return false;
+            }
+        } else if (std::strcmp(argv[i], "-g") == 0) {
+            options.grade = true;
+        } else if (std::strcmp(argv[i], "-o") == 0 && hasValue) {
+            options.output = argv[++i];
+        } else if (argv[i][0] != '-' || std::strcmp(argv[i], "-") == 0) {
+            options.input = argv[i];
+        } else {
+            return false;
+        }
+    }
+    return options.threads >= 0;
+}
+
+// Takes the puzzle from the front of a line; collections often append a
+// rating or a solution after a space, tab or comma
+std::string puzzleField(const std::string& line) {
+    size_t end = line.find_first_of(" \t,;\r");
+    return line.substr(0, end);
+}
+
+void solveBatch(Batch& batch, Sudoku& sudoku) {
+    for (auto& line : batch.lines) {
+        if (!sudoku.loadPuzzle(puzzleField(line))) {
+            line = "invalid";
+            batch.invalid++;
+        } else if (!sudoku.solve()) {
+            line = "unsolvable";
+            batch.unsolvable++;
+        } else {
+            line = sudoku.toString();
+            batch.solved++;
+        }
+    }
+}
+
+std::string gridToString(const SudokuGrid& grid) {
+    std::string text(grid.size(), '.');
+    for (size_t cell = 0; cell < grid.size(); cell++) {
+        text[cell] = static_cast<char>('0' + grid[cell]);
+    }
+    return text;
+}
+
+// Rates each puzzle instead of solving it; puzzles that logic alone cannot
+// finish count as unsolvable and are rated "Guess"
+void gradeBatch(Batch& batch, Sudoku& sudoku, Grader& grader) {
+    for (auto& line : batch.lines) {
+        std::string puzzle = puzzleField(line);
+        if (!sudoku.loadPuzzle(puzzle)) {
+            line = "invalid";
+            batch.invalid++;
+            continue;
+        }
+        Grade grade = grader.grade(sudoku.getDigits());
+        line = puzzle + ' ' + std::to_string(grade.score) + ' ' + getTechniqueName(grade.hardest);
+        if (grade.solved) {
+            batch.solved++;
+        } else {
+            batch.unsolvable++;
+        }
+    }
+}
+
+// Same as solveBatch, but valid puzzles are gathered into vector-width groups
+void solveBatchVectorized(Batch& batch, Sudoku& sudoku, BatchSolver& solver) {
+    SudokuGrid grids[BatchSolver::MAX_LANES];
+    size_t lineOf[BatchSolver::MAX_LANES];
+    bool solved[BatchSolver::MAX_LANES];
+    int pending = 0;
+
+    auto flush = [&]() {
+        solver.solve(grids, solved, pending);
+        for (int i = 0; i < pending; i++) {
+            if (solved[i]) {
+                batch.lines[lineOf[i]] = gridToString(grids[i]);
+                batch.solved++;
+            } else {
+                batch.lines[lineOf[i]] = "unsolvable";
+                batch.unsolvable++;
+            }
+        }
+        pending = 0;
+    };
+
+    for (size_t i = 0; i < batch.lines.size(); i++) {
+        if (!sudoku.loadPuzzle(puzzleField(batch.lines[i]))) {
+            batch.lines[i] = "invalid";
+            batch.invalid++;
+            continue;
+        }
+        grids[pending] = sudoku.getDigits();
+        lineOf[pending++] = i;
+        if (pending == solver.getLanes()) {
+            flush();
+        }
+    }
+    if (pending > 0) {
+        flush();
+    }
+}
+
+// Fixed set of workers solving whole batches; each keeps one Sudoku for its lifetime
+class WorkerPool {
+public:
+    WorkerPool(int threadCount, const Options& options) : stopping(false) {
+        for (int t = 0; t < threadCount; t++) {
+            workers.emplace_back([this, options]() { workerLoop(options); });
+        }
+    }
+
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        queueChanged.notify_all();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    void submit(const std::shared_ptr<Batch>& batch) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            queue.push_back(batch);
+        }
+        queueChanged.notify_one();
+    }
+
+    void waitFor(const Batch& batch) {
+        std::unique_lock<std::mutex> lock(mutex);
+        batchDone.wait(lock, [&batch]() { return batch.done; });
+    }
+
+private:
+    std::vector<std::thread> workers;
+    std::deque<std::shared_ptr<Batch>> queue;
+    std::mutex mutex;
+    std::condition_variable queueChanged;
+    std::condition_variable batchDone;
+    bool stopping;
+
+    void workerLoop(Options options) {
+        Sudoku sudoku{EmptyBoard()};
+        sudoku.setSolverEngine(options.engine);
+        BatchSolver batchSolver;
+        Grader grader;
+
+        while (true) {
+            std::shared_ptr<Batch> batch;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                queueChanged.wait(lock, [this]() { return stopping || !queue.empty(); });
+                if (queue.empty()) return;
+                batch = queue.front();
+                queue.pop_front();
+            }
+
+            if (options.grade) {
+                gradeBatch(*batch, sudoku, grader);
+            } else if (options.vectorized) {
+                solveBatchVectorized(*batch, sudoku, batchSolver);
+            } else {
+                solveBatch(*batch, sudoku);
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                batch->done = true;
+            }
+            batchDone.notify_all();
+        }
+    }
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+
+    std::ifstream file;
+    std::istream* in = &std::cin;
+    if (options.input && std::strcmp(options.input, "-") != 0) {
+        file.open(options.input);
+        if (!file) {
+            std::cerr << "Failed to open " << options.input << std::endl;
+            return 1;
+        }
+        in = &file;
+    }
+    std::ios::sync_with_stdio(false);
+
+    FILE* out = stdout;
+    if (options.output) {
+        out = std::fopen(options.output, "w");
+        if (!out) {
+            std::cerr << "Failed to open " << options.output << " for writing" << std::endl;
+            return 1;
+        }
+    }
+
+    int cores = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    int threads = options.threads > 0 ? options.threads : cores;
+    if (options.engine == SolverEngine::Parallel) {
+        threads = 1;   // the parallel engine already keeps every core busy on one puzzle
+    }
+    const size_t maxInFlight = MAX_IN_FLIGHT_PER_THREAD * threads;
+
+    size_t total = 0, solved = 0, unsolvable = 0, invalid = 0;
+    auto start = std::chrono::steady_clock::now();
+    {
+        WorkerPool pool(threads, options);
+        std::deque<std::shared_ptr<Batch>> inFlight;
+
+        // Writes the oldest batch once it is done, keeping output in input order
+        auto retireOldest = [&]() {
+            std::shared_ptr<Batch> batch = inFlight.front();
+            inFlight.pop_front();
+            pool.waitFor(*batch);
+            for (const auto& line : batch->lines) {
+                std::fwrite(line.data(), 1, line.size(), out);
+                std::fputc('\n', out);
+            }
+            solved += batch->solved;
+            unsolvable += batch->unsolvable;
+            invalid += batch->invalid;
+        };
+
+        std::string line;
+        bool more = true;
+        while (more) {
+            auto batch = std::make_shared<Batch>();
+            batch->lines.reserve(BATCH_SIZE);
+            while (batch->lines.size() < BATCH_SIZE && (more = static_cast<bool>(std::getline(*in, line)))) {
+                if (line.empty() || line[0] == '#') continue;
+                batch->lines.push_back(line);
+            }
+            if (batch->lines.empty()) break;
+
+            total += batch->lines.size();
+            pool.submit(batch);
+            inFlight.push_back(batch);
+            // Bound memory: never hold more than maxInFlight batches
+            if (inFlight.size() >= maxInFlight) {
+                retireOldest();
+            }
+        }
+        while (!inFlight.empty()) {
+            retireOldest();
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (out != stdout) {
+        std::fclose(out);
+    }
+    std::fprintf(stderr, "%zu puzzles (%zu solved, %zu unsolvable, %zu invalid) in %.3f s: %.1f puzzles/sec on %d threads%s\n",
+                 total, solved, unsolvable, invalid, seconds, total / seconds, threads,
+                 options.grade ? " (graded)" :
+                 options.vectorized ? (BatchSolver::hasAvx2() ? " (avx2 kernel)" : " (portable kernel)") : "");
+    return 0;
+}